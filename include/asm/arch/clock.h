@@ -148,7 +148,7 @@ struct anatop_reg {
 #define PLL_SS_EN BIT(15)
 
 struct imx_fracpll_rate_table {
-	u32 rate; /*khz*/
+	u32 rate; /* Hz */
 	u32 rdiv;
 	u32 mfi;
 	u32 odiv;
@@ -156,29 +156,27 @@ struct imx_fracpll_rate_table {
 	u32 mfd;
 };
 
-#define FRAC_PLL_RATE(_rate, _r, _m, _o, _n, _d)			\
-	{							\
-		.rate	=	(_rate),			\
-		.rdiv	=	(_r),				\
-		.mfi	=	(_m),				\
-		.odiv	=	(_o),				\
-		.mfn	=	(_n),				\
-		.mfd	=	(_d),				\
-	}
-
-struct clk_root_map {
-	u32 clk_root_id;
-	u32 mux_type;
-};
-
 int clock_init(void);
-void dram_pll_init(ulong pll_val);
-void dram_enable_bypass(ulong clk_val);
+#if defined(CONFIG_CPU_BOOST)
+int clock_cpu_boost(u32 *ctrl);
+int clock_cpu_restore(u32 ctrl);
+#endif
+int dram_pll_init(ulong pll_val);
+int dram_enable_bypass(ulong clk_val);
 void dram_disable_bypass(void);
 
+/* max fracPLL lock time after power-up, fracpll_lock() polls up to it */
+#define FRACPLL_LOCK_US		100
+
 #ifdef CONFIG_IMX95
 int configure_fracpll(enum ccm_clk_src clksrc, u32 freq);
+int fracpll_start(enum ccm_clk_src clksrc, u32 freq);
+int fracpll_lock(enum ccm_clk_src clksrc);
+bool fracpll_locked(enum ccm_clk_src clksrc);
+u32 fracpll_lock_time(enum ccm_clk_src clksrc, u32 *freq);
 #endif
 int ccm_clk_root_cfg(u32 clk_root_id, enum ccm_clk_src src, u32 div);
+int ccm_clk_root_save(u32 clk_root_id, u32 *ctrl);
+int ccm_clk_root_restore(u32 clk_root_id, u32 ctrl);
 int ccm_shared_gpr_set(u32 gpr, u32 val);
 #endif
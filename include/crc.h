@@ -12,4 +12,11 @@
  */
 u32 crc32(const void *addr, u32 length);
 
+/**
+ * Continue a CRC over the next length bytes, crc is the value returned for
+ * the previous bytes (0 to start): crc32_update(crc32(a, n), a + n, m) is
+ * crc32(a, n + m)
+ */
+u32 crc32_update(u32 crc, const void *addr, u32 length);
+
 #endif
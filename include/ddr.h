@@ -88,6 +88,61 @@ struct __attribute__((__packed__)) ddrphy_cfg_param {
 	unsigned short val;
 };
 
+/**
+ * DDR register sequence bytecode, run by ddr_seq_run().
+ *
+ * A sequence is a stream of halfwords. Each instruction starts with a
+ * header halfword holding the opcode in [15:12]; 32-bit operands follow
+ * as two halfwords, low half first.
+ *
+ * BURST/FILL: [11:8] PHY APB address bits 19..16, [7:0] register count,
+ *	then APB address bits 15..0 and either <count> values written to
+ *	consecutive APB addresses (BURST) or one value written <count>
+ *	times (FILL). The run-encoded PHY tables generated with
+ *	CONFIG_DDRPHY_BURST only use these two opcodes.
+ * WRITE: addr, val			writel(val, addr)
+ * RMW:   addr, clr, set		writel((readl(addr) & ~clr) | set, addr)
+ * POLL:  [11:0] timeout in us (0: none), addr, mask, val
+ *	wait for (readl(addr) & mask) == val, -ETIMEDOUT on timeout
+ * DELAY: [11:0] delay in us
+ *
+ * The [11:0] header arguments are checked at build time, a timeout or a
+ * delay above 4095 us does not build.
+ */
+#define DDR_SEQ_BURST		0x0
+#define DDR_SEQ_FILL		0x1
+#define DDR_SEQ_WRITE		0x2
+#define DDR_SEQ_RMW		0x3
+#define DDR_SEQ_POLL		0x4
+#define DDR_SEQ_DELAY		0x5
+
+#define DDR_SEQ_ARG_MAX		0xfff
+#define DDR_SEQ_ARG(arg) \
+	((arg) + 0 * sizeof(char[(unsigned int)(arg) <= DDR_SEQ_ARG_MAX ? 1 : -1]))
+#define DDR_SEQ_HDR(op, arg)	(((op) << 12) | DDR_SEQ_ARG(arg))
+#define DDR_SEQ_U32(x)		((x) & 0xffff), (((x) >> 16) & 0xffff)
+
+#define DDRPHY_RUN(op, addr, num) \
+	(((op) << 12) | ((((addr) >> 16) & 0xf) << 8) | ((num) & 0xff)), ((addr) & 0xffff)
+#define DDRPHY_BURST(addr, num)	DDRPHY_RUN(DDR_SEQ_BURST, addr, num)
+#define DDRPHY_FILL(addr, num)	DDRPHY_RUN(DDR_SEQ_FILL, addr, num)
+
+#define SEQ_PHY_WR(addr, val)	DDRPHY_BURST(addr, 1), (val)
+#define SEQ_WR(addr, val)	DDR_SEQ_HDR(DDR_SEQ_WRITE, 0), DDR_SEQ_U32(addr), DDR_SEQ_U32(val)
+#define SEQ_CLRSETBITS(addr, clr, set) \
+	DDR_SEQ_HDR(DDR_SEQ_RMW, 0), DDR_SEQ_U32(addr), DDR_SEQ_U32(clr), DDR_SEQ_U32(set)
+#define SEQ_SETBITS(addr, set)	SEQ_CLRSETBITS(addr, 0, set)
+#define SEQ_CLRBITS(addr, clr)	SEQ_CLRSETBITS(addr, clr, 0)
+#define SEQ_POLL(addr, mask, val, timeout_us) \
+	DDR_SEQ_HDR(DDR_SEQ_POLL, timeout_us), DDR_SEQ_U32(addr), DDR_SEQ_U32(mask), DDR_SEQ_U32(val)
+#define SEQ_UDELAY(us)		DDR_SEQ_HDR(DDR_SEQ_DELAY, us)
+
+#if defined(CONFIG_DDRPHY_BURST)
+typedef unsigned short ddrphy_cfg_tbl;
+#else
+typedef struct ddrphy_cfg_param ddrphy_cfg_tbl;
+#endif
+
 struct dram_fsp_cfg {
 	struct ddrc_cfg_param *ddrc_cfg;
 	unsigned int ddrc_cfg_num;
@@ -100,14 +155,16 @@ struct dram_fsp_msg {
 	unsigned int drate;
 	enum fw_type fw_type;
 	/* pstate ddrphy config */
-	struct ddrphy_cfg_param *fsp_phy_cfg;
+	ddrphy_cfg_tbl *fsp_phy_cfg;
 	unsigned int fsp_phy_cfg_num;
 	/* pstate message block(header) */
 	struct ddrphy_cfg_param *fsp_phy_msgh_cfg;
 	unsigned int fsp_phy_msgh_cfg_num;
 	/* pstate PIE */
-	struct ddrphy_cfg_param *fsp_phy_pie_cfg;
+	ddrphy_cfg_tbl *fsp_phy_pie_cfg;
 	unsigned int fsp_phy_pie_cfg_num;
+	/* SequenceCtrl training steps, 0 for the message block value */
+	unsigned int train_steps;
 
 	/* for simulation */
 	struct ddrphy_cfg_param *fsp_phy_prog_csr_ps_cfg;
@@ -122,7 +179,7 @@ struct dram_timing_info {
 	struct dram_fsp_cfg *fsp_cfg;
 	unsigned int fsp_cfg_num;
 	/* ddrphy config */
-	struct ddrphy_cfg_param *ddrphy_cfg;
+	ddrphy_cfg_tbl *ddrphy_cfg;
 	unsigned int ddrphy_cfg_num;
 	/* ddr fsp train info */
 	struct dram_fsp_msg *fsp_msg;
@@ -131,7 +188,7 @@ struct dram_timing_info {
 	struct ddrphy_cfg_param *ddrphy_trained_csr;
 	unsigned int ddrphy_trained_csr_num;
 	/* ddr phy common PIE */
-	struct ddrphy_cfg_param *ddrphy_pie;
+	ddrphy_cfg_tbl *ddrphy_pie;
 	unsigned int ddrphy_pie_num;
 	/* initialized drate table */
 	unsigned int fsp_table[4];
@@ -139,23 +196,160 @@ struct dram_timing_info {
 
 extern struct dram_timing_info dram_timing;
 
+/**
+ * Overlapped DDR bring-up.
+ *
+ * The DRAM PLL is started right after the PHY cold reset, with the DRAM
+ * clock root parked on the CCM so that the PHY stays clocked, and locks
+ * while the reset settle window, the PHY common config and the IMEM load
+ * proceed. These only write CSRs and SRAM over APB, the PHY runs its
+ * whole training from the same CCM bypass for the lower drates; the
+ * frequency dependent FSP config is written once the PLL drives the DFI
+ * clock. The ordering constraints are:
+ *  - no PHY APB access before the post-reset settle window has elapsed,
+ *    see ddr_bringup_phy_ready();
+ *  - IMEM is loaded after the PHY common config, which turns the SRAM
+ *    ECC initialization off;
+ *  - the DRAM clock root is switched to the PLL once it has locked and
+ *    no firmware eDMA transfer is in flight, see ddr_bringup_clk_ready();
+ *  - the PMU is run once IMEM and DMEM are completely loaded, see
+ *    ddr_fw_xfer_wait().
+ * Deadlines are timer_get_us() values.
+ */
+struct ddr_bringup {
+	u32 settle_us;
+	u32 lock_us;
+	bool pll_pending;
+};
+
+/* Firmware image load in flight, i halfwords out of num are copied */
+struct ddr_fw_xfer {
+	unsigned long fw;
+	unsigned long dst;
+	u32 i;
+	u32 num;
+	bool dma;
+};
+
+/* PHY SRAM block copy in flight, to the PHY or from it */
+struct ddrphy_sram_xfer {
+	u16 *buf;
+	u32 addr;
+	u32 num;
+	bool to_phy;
+	bool dma;
+};
+
 void ddr_load_train_firmware(struct dram_fsp_msg *fsp_msg, enum mem_type type);
+void ddrphy_prepare_mb(u16 *mb, struct dram_fsp_msg *fsp_msg);
+void ddr_fw_xfer_start(struct ddr_fw_xfer *xfer, enum mem_type type);
+u32 ddr_fw_xfer_step(struct ddr_fw_xfer *xfer, u32 num);
+void ddr_fw_xfer_wait(struct ddr_fw_xfer *xfer);
+void ddrphy_sram_xfer_start(struct ddrphy_sram_xfer *xfer, u16 *buf, u32 addr, u32 num,
+			    bool to_phy);
+void ddrphy_sram_xfer_wait(struct ddrphy_sram_xfer *xfer);
 int ddr_init(struct dram_timing_info *timing_info);
-int ddr_cfg_phy(struct dram_timing_info *timing_info);
+
+/**
+ * Training steps, SequenceCtrl bits of the message block. The steps run
+ * for a FSP are its train_steps, or the message block SequenceCtrl, masked
+ * with DDRPHY_TRAIN_STEPS (TRAIN_STEPS=<mask> build option).
+ */
+#define DDRPHY_MSB_SEQ_CTRL	0x8	/* halfword offset in the message block */
+
+#define DDRPHY_STEP_DEVINIT	BIT(0)
+#define DDRPHY_STEP_WRLVL	BIT(1)
+#define DDRPHY_STEP_RXEN	BIT(2)
+#define DDRPHY_STEP_RDDQS1D	BIT(3)
+#define DDRPHY_STEP_WRDQ1D	BIT(4)
+#define DDRPHY_STEP_RDDESKEW	BIT(8)
+#define DDRPHY_STEP_MXRDLAT	BIT(9)
+#define DDRPHY_STEP_LPCA	BIT(10)
+
+#ifndef DDRPHY_TRAIN_STEPS
+#define DDRPHY_TRAIN_STEPS	0xffff
+#endif
 
 /* utils function for ddr phy training */
 int wait_ddrphy_training_complete(void);
-void ddrphy_init_set_dfi_clk(unsigned int drate);
+int ddrphy_pmu_run(void);
+int ddrphy_init_set_dfi_clk(unsigned int drate);
+int ddrphy_dfi_clk_start(struct ddr_bringup *bu, unsigned int drate);
+void ddr_bringup_phy_ready(struct ddr_bringup *bu);
+int ddr_bringup_clk_ready(struct ddr_bringup *bu, struct ddr_fw_xfer *xfer);
 void ddrphy_init_read_msg_block(void);
-void ddrphy_cfg_set(struct ddrphy_cfg_param *cfg, unsigned int num);
+u16 ddrphy_train_steps(struct dram_fsp_msg *fsp_msg);
+int ddrphy_train_steps_check(struct dram_fsp_msg *fsp_msg);
+int ddrphy_cfg_set(ddrphy_cfg_tbl *cfg, unsigned int num);
+int ddr_seq_run(const unsigned short *seq, unsigned int len);
 
-#define ddrphy_addr_remap(paddr_apb_from_ctlr)	(paddr_apb_from_ctlr << 2)
+#define ddr_seq_exec(s)		ddr_seq_run(s, ARRAY_SIZE(s))
+
+#define ddrphy_addr_remap(paddr_apb_from_ctlr)	((paddr_apb_from_ctlr) << 2)
 
 #define dwc_ddrphy_apb_wr(addr, data) \
 	writel(data, IP2APB_DDRPHY_IPS_BASE_ADDR(0) + ddrphy_addr_remap(addr))
 #define dwc_ddrphy_apb_rd(addr) \
 	readl(IP2APB_DDRPHY_IPS_BASE_ADDR(0) + ddrphy_addr_remap(addr))
 
+/**
+ * Training timeline, CONFIG_DDR_TRAIN_LOG.
+ *
+ * Each PMU mail is recorded with its timer_get_us() arrival time, in a
+ * fixed-size record kept in free M33 TCMU space. A major message ends a
+ * training step. A streaming message is recorded as its string index,
+ * followed by one entry per argument. scripts/ddr_train_log.py decodes a
+ * dump of the record.
+ */
+#define DDR_TRAIN_LOG_MEM	0x30000000
+#define DDR_TRAIN_LOG_MAGIC	0x474c5444	/* "DTLG" */
+#define DDR_TRAIN_LOG_NUM	1024
+
+#define DDR_TRAIN_LOG_RUN	0	/* val: drate of the firmware run */
+#define DDR_TRAIN_LOG_MAJOR	1	/* val: major message */
+#define DDR_TRAIN_LOG_STRING	2	/* val: streaming message string index */
+#define DDR_TRAIN_LOG_ARG	3	/* val: streaming message argument */
+#define DDR_TRAIN_LOG_STEPS	4	/* val: SequenceCtrl of the firmware run */
+
+struct ddr_train_log_ent {
+	u32 ts;
+	u32 type;
+	u32 val;
+};
+
+struct ddr_train_log {
+	u32 magic;
+	u32 num;
+	u32 lost;
+	u32 rsvd;
+	struct ddr_train_log_ent ent[DDR_TRAIN_LOG_NUM];
+};
+
+#if defined(CONFIG_DDR_TRAIN_LOG)
+void ddr_train_log_init(void);
+void ddr_train_log(u32 type, u32 val);
+#else
+#define ddr_train_log_init()
+#define ddr_train_log(type, val)
+#endif
+#if defined(CONFIG_DDR_TRAIN_LOG) && defined(DEBUG)
+void ddr_train_log_summary(void);
+#else
+#define ddr_train_log_summary()
+#endif
+
+/**
+ * DDR flows built in: QuickBoot with CONFIG_DDR_QBOOT, training otherwise.
+ * CONFIG_DDR_QBOOT_AUTO builds both, ddr_init() then runs QuickBoot when
+ * the saved QB state is valid and falls back to training.
+ */
+#if defined(CONFIG_DDR_QBOOT) || defined(CONFIG_DDR_QBOOT_AUTO)
+#define DDR_QB_FLOW
+#endif
+#if !defined(CONFIG_DDR_QBOOT) || defined(CONFIG_DDR_QBOOT_AUTO)
+#define DDR_TRAIN_FLOW
+#endif
+
 /* Quick Boot related */
 #if (!defined(DDR5) && !defined(DDR4x))
 #error "Please specify either -DDDR5 or -DDDR4x !"
@@ -167,7 +361,8 @@ void ddrphy_cfg_set(struct ddrphy_cfg_param *cfg, unsigned int num);
 
 /**
  * No PSTATE SRAM is saved by default, one Pstate defined.
- * PSTATE SRAM to be saved if 3 and more Pstates are defined.
+ * PSTATE SRAM to be saved if 3 and more Pstates are defined,
+ * boards training 3 FSPs or more set DDRPHY_PSTATES.
  */
 #if (defined(DDRPHY_PSTATES) && DDRPHY_PSTATES >= 3)
 #define DDRPHY_QB_PSTATES	DDRPHY_PSTATES
@@ -176,12 +371,31 @@ void ddrphy_cfg_set(struct ddrphy_cfg_param *cfg, unsigned int num);
 #endif
 #define DDRPHY_QB_PST_SIZE	DDRPHY_QB_PSTATES * 4 * 1024
 
+/**
+ * CSR save list, range encoded by scripts/ddr_qb_csr.py: a group repeats
+ * its runs for inst instances inst_stride apart, a run lists count PHY
+ * addresses stride apart from base.
+ */
+struct ddrphy_csr_run {
+	u32 base;
+	u16 count;
+	int16 stride;
+};
+
+struct ddrphy_csr_grp {
+	u16 runs;
+	u16 inst;
+	int32 inst_stride;
+};
+
 #define ACSM_SRAM_BASE_ADDR	0x41000
 #define PSTATE_SRAM_BASE_ADDR	0xA0000
 
 #define QB_STATE_MEM		0x4aaf4000
+/* FSPs of a QuickBoot state, as many as dram_timing_info.fsp_table[] */
+#define DDRPHY_QB_FSP_MAX	4
+/* Trained values saved from the message block, for each FSP */
 typedef struct {
-	u32 crc;
 	u8 TrainedVREFCA_A0;
 	u8 TrainedVREFCA_A1;
 	u8 TrainedVREFCA_B0;
@@ -202,16 +416,93 @@ typedef struct {
 	u8 TrainedDRAMDCA_A1;
 	u8 TrainedDRAMDCA_B0;
 	u8 TrainedDRAMDCA_B1;
-	u16 csr[DDRPHY_QB_CSR_SIZE];
-	u16 acsm[DDRPHY_QB_ACSM_SIZE];
-	u16 pst[DDRPHY_QB_PST_SIZE];
-} ddrphy_qb_state;
-
-#if defined(CONFIG_DDR_QBOOT)
-int ddr_cfg_phy_qb(struct dram_timing_info *timing_info, int fsp_id);
-void ddr_load_DMEM(u16 *msg_blk, ddrphy_qb_state *qb_state);
-u32 ddr_get_qb_state_addr(void);
+} ddrphy_qb_mr;
+
+/**
+ * QuickBoot state container: a header, then the MR, CSR, ACSM and PState
+ * SRAM sections at the offsets of its section table and a commit word,
+ * ~crc of the header, written last. The header is checked before any
+ * section, a state saved by another build, for another DRAM type or
+ * other FSP data rates is rejected from it. Each section has its own CRC so
+ * it can be checked while the previous one is loaded. The MR section holds
+ * one ddrphy_qb_mr per FSP, in dram_timing_info.fsp_msg[] order.
+ *
+ * The image holds two slots of DDRPHY_QB_SLOT_SIZE bytes after the PHY
+ * firmware. QuickBoot restores the valid slot of the newest generation,
+ * the training flow saves the next generation for the other slot, so an
+ * interrupted update leaves the previous state bootable. A training-only
+ * image does not see the slots: it saves the state with DDRPHY_QB_GEN_NONE
+ * and DDRPHY_QB_SLOT_NONE, scripts/ddr_qb_stamp.py picks the slot and the
+ * generation when writing it to the image.
+ */
+#define DDRPHY_QB_MAGIC		0x42514444	/* "DDQB" */
+#define DDRPHY_QB_VERSION	3
+#define DDRPHY_QB_F_RLE		BIT(0)
+
+#if defined(DDR5)
+#define DDRPHY_QB_DDR_TYPE	5
 #else
-void ddrphy_qb_save(void);
+#define DDRPHY_QB_DDR_TYPE	4
+#endif
+
+enum {
+	DDRPHY_QB_SECT_MR,
+	DDRPHY_QB_SECT_CSR,
+	DDRPHY_QB_SECT_ACSM,
+	DDRPHY_QB_SECT_PST,
+	DDRPHY_QB_SECT_NUM,
+};
+
+struct ddrphy_qb_sect {
+	u32 offset;	/* from the header */
+	u32 size;	/* bytes */
+	u32 crc;
+};
+
+typedef struct {
+	u32 magic;
+	u16 version;
+	u16 flags;
+	u32 ddr_type;
+	u32 fsp_num;
+	u32 drate[DDRPHY_QB_FSP_MAX];	/* MT/s of each trained FSP */
+	u32 csr_hash;	/* DDRPHY_QB_CSR_HASH of the CSR save list */
+	u32 gen;	/* generation, the newest valid slot is restored */
+	u32 slot;	/* slot the state is written to */
+	u32 size;	/* offset of the commit word */
+	struct ddrphy_qb_sect sect[DDRPHY_QB_SECT_NUM];
+	u32 crc;	/* of the header above */
+} ddrphy_qb_hdr;
+
+/**
+ * Compressed sections (QB_COMPRESS=yes, DDRPHY_QB_F_RLE): the CSR, ACSM
+ * and PState SRAM sections are run-length encoded. A token halfword with
+ * bit 15 set repeats the next halfword ([14:0] + 1) times, otherwise
+ * ([14:0] + 1) literal halfwords follow. An encoded section is at most
+ * one halfword per started 32K halfwords larger than the raw one.
+ */
+#define DDRPHY_QB_RLE_RUN	0x8000
+#define DDRPHY_QB_RLE_MAX	(DDRPHY_QB_CSR_SIZE + DDRPHY_QB_ACSM_SIZE + DDRPHY_QB_PST_SIZE + 3 + \
+				 DDRPHY_QB_PST_SIZE / DDRPHY_QB_RLE_RUN)
+
+/* Sections are 4 bytes aligned */
+#define DDRPHY_QB_STATE_MAX	(sizeof(ddrphy_qb_hdr) + DDRPHY_QB_FSP_MAX * sizeof(ddrphy_qb_mr) + \
+				 DDRPHY_QB_RLE_MAX * sizeof(u16) + 4 * DDRPHY_QB_SECT_NUM)
+
+#define DDRPHY_QB_SLOTS		2
+#define DDRPHY_QB_GEN_NONE	0
+#define DDRPHY_QB_SLOT_NONE	0xffffffff
+#define DDRPHY_QB_SLOT_SIZE	((DDRPHY_QB_STATE_MAX + sizeof(u32) + 0xfff) & ~0xfffU)
+
+#if defined(DDR_QB_FLOW)
+int ddr_cfg_phy_qb(struct dram_timing_info *timing_info, int fsp_id, struct ddr_bringup *bu);
+void ddr_load_DMEM(u16 *msg_blk, const u16 *csr);
+u32 ddr_get_qb_state_addr(void);
+u32 ddrphy_qb_slots(ddrphy_qb_hdr **slots, struct dram_timing_info *dtiming);
+#endif
+#if defined(DDR_TRAIN_FLOW)
+int ddr_cfg_phy(struct dram_timing_info *timing_info, struct ddr_bringup *bu, ddrphy_qb_mr *mr);
+void ddrphy_qb_read_mr(ddrphy_qb_mr *mr);
+void ddrphy_qb_save(struct dram_timing_info *dtiming, ddrphy_qb_mr *mr);
 #endif
 #endif
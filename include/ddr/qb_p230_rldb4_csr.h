@@ -0,0 +1,615 @@
+/* Generated by scripts/ddr_qb_csr.py from include/ddr/qb_p230_rldb4.h, do not edit */
+#ifndef DDRPHY_QB_CSR_H
+#define DDRPHY_QB_CSR_H
+#include "ddr.h"
+
+#if DDRPHY_QB_CSR_SIZE != 5168
+#error "ddrphy_csr_cfg does not match DDRPHY_QB_CSR_SIZE"
+#endif
+
+#define DDRPHY_QB_CSR_HASH	0xc5890b59
+
+static const struct ddrphy_csr_run ddrphy_csr_runs[] = {
+	{ 0x100a3, 2, -77 },
+	{ 0x100d9, 2, -89 },
+	{ 0x10081, 7, 1 },
+	{ 0x300ad, 2, 1 },
+	{ 0x300ac, 2, -28 },
+	{ 0x30091, 6, 1 },
+	{ 0xc0086, 2, 106 },
+	{ 0xc00f1, 15, 1 },
+	{ 0x20090, 2, -63 },
+	{ 0x20300, 2, 3 },
+	{ 0x20302, 2, 38 },
+	{ 0x20301, 2, 10 },
+	{ 0x20077, 2, -46 },
+	{ 0x908ff, 1, 1 },
+	{ 0x20071, 2, 19 },
+	{ 0x20085, 2, 3 },
+	{ 0x20089, 2, 1 },
+	{ 0x2008c, 2, 25 },
+	{ 0x200c6, 2, 190 },
+	{ 0x20185, 2, 3 },
+	{ 0x20189, 2, 1 },
+	{ 0x20200, 2, 261 },
+	{ 0x20306, 5, 1 },
+	{ 0x2030c, 4, 1 },
+	{ 0x20318, 16, 1 },
+	{ 0x20019, 1, 1 },
+	{ 0x90802, 2, 238 },
+	{ 0x908f1, 7, 1 },
+	{ 0x90801, 2, 9 },
+	{ 0x20002, 2, -2 },
+	{ 0x20007, 2, 12 },
+	{ 0x20004, 2, -1 },
+	{ 0x20001, 2, 8 },
+	{ 0x20008, 2, 12 },
+	{ 0x20331, 2, -799 },
+	{ 0x20017, 2, -13 },
+	{ 0x20186, 2, 1 },
+	{ 0x20010, 2, 1 },
+	{ 0x2002c, 2, 1 },
+	{ 0x20030, 2, -2 },
+	{ 0x2002f, 2, 31 },
+	{ 0x2004c, 2, 1 },
+	{ 0x20035, 12, 1 },
+	{ 0x2000c, 2, 62 },
+	{ 0x2004b, 2, 741 },
+	{ 0x30038, 3, 1 },
+	{ 0x30050, 4, 1 },
+	{ 0x30030, 2, 1 },
+	{ 0x30035, 2, 7 },
+	{ 0x30040, 4, 1 },
+	{ 0x30330, 2, -744 },
+	{ 0x30049, 3, 1 },
+	{ 0x30033, 2, 1 },
+	{ 0x3002e, 2, 4106 },
+	{ 0x31039, 2, 1 },
+	{ 0x31050, 4, 1 },
+	{ 0x31030, 2, 1 },
+	{ 0x31035, 2, 7 },
+	{ 0x31040, 4, 1 },
+	{ 0x31330, 2, -744 },
+	{ 0x31049, 3, 1 },
+	{ 0x31033, 2, 1 },
+	{ 0x3102e, 1, 1 },
+	{ 0x100d0, 5, 1 },
+	{ 0x100af, 2, -2 },
+	{ 0x10000, 2, 56 },
+	{ 0x1003a, 2, 1 },
+	{ 0x10004, 2, -1 },
+	{ 0x10030, 2, 5 },
+	{ 0x1003c, 2, 2 },
+	{ 0x10006, 2, 58 },
+	{ 0x10042, 2, 1 },
+	{ 0x10048, 2, 2 },
+	{ 0x1004b, 2, -24 },
+	{ 0x1002e, 2, 119 },
+	{ 0x10014, 2, 67 },
+	{ 0x1004e, 4, 1 },
+	{ 0x1014e, 4, 1 },
+	{ 0x1024e, 4, 1 },
+	{ 0x1034e, 4, 1 },
+	{ 0x1044e, 4, 1 },
+	{ 0x1054e, 4, 1 },
+	{ 0x1064e, 4, 1 },
+	{ 0x1074e, 4, 1 },
+	{ 0x1084e, 4, 1 },
+	{ 0x1000c, 2, 1 },
+	{ 0x190802, 2, 238 },
+	{ 0x1908f1, 7, 1 },
+	{ 0x190801, 2, 9 },
+	{ 0x120002, 2, -2 },
+	{ 0x120007, 2, 12 },
+	{ 0x120004, 2, -1 },
+	{ 0x120001, 2, 8 },
+	{ 0x120008, 2, 12 },
+	{ 0x120331, 2, -799 },
+	{ 0x120017, 2, -13 },
+	{ 0x120186, 2, 1 },
+	{ 0x120010, 2, 1 },
+	{ 0x12002c, 2, 1 },
+	{ 0x120030, 2, -2 },
+	{ 0x12002f, 2, 31 },
+	{ 0x12004c, 2, 1 },
+	{ 0x120035, 12, 1 },
+	{ 0x12000c, 2, 62 },
+	{ 0x12004b, 2, 741 },
+	{ 0x130038, 3, 1 },
+	{ 0x130050, 4, 1 },
+	{ 0x130030, 2, 1 },
+	{ 0x130035, 2, 7 },
+	{ 0x130040, 4, 1 },
+	{ 0x130330, 2, -744 },
+	{ 0x130049, 3, 1 },
+	{ 0x130033, 2, 1 },
+	{ 0x13002e, 2, 4106 },
+	{ 0x131039, 2, 1 },
+	{ 0x131050, 4, 1 },
+	{ 0x131030, 2, 1 },
+	{ 0x131035, 2, 7 },
+	{ 0x131040, 4, 1 },
+	{ 0x131330, 2, -744 },
+	{ 0x131049, 3, 1 },
+	{ 0x131033, 2, 1 },
+	{ 0x13102e, 1, 1 },
+	{ 0x1100d0, 5, 1 },
+	{ 0x1100af, 2, -2 },
+	{ 0x110000, 2, 56 },
+	{ 0x11003a, 2, 1 },
+	{ 0x110004, 2, -1 },
+	{ 0x110030, 2, 5 },
+	{ 0x11003c, 2, 2 },
+	{ 0x110006, 2, 58 },
+	{ 0x110042, 2, 1 },
+	{ 0x110048, 2, 2 },
+	{ 0x11004b, 2, -24 },
+	{ 0x11002e, 2, 119 },
+	{ 0x110014, 2, 67 },
+	{ 0x11004e, 4, 1 },
+	{ 0x11014e, 4, 1 },
+	{ 0x11024e, 4, 1 },
+	{ 0x11034e, 4, 1 },
+	{ 0x11044e, 4, 1 },
+	{ 0x11054e, 4, 1 },
+	{ 0x11064e, 4, 1 },
+	{ 0x11074e, 4, 1 },
+	{ 0x11084e, 4, 1 },
+	{ 0x11000c, 2, 1 },
+	{ 0x30001, 10, 256 },
+	{ 0x30006, 2, 2 },
+	{ 0x30002, 2, 3 },
+	{ 0x130001, 10, 256 },
+	{ 0x130006, 2, 2 },
+	{ 0x130002, 2, 3 },
+	{ 0x10024, 2, -20 },
+	{ 0x10012, 2, 20 },
+	{ 0x10124, 2, -20 },
+	{ 0x10112, 2, 20 },
+	{ 0x10224, 2, -20 },
+	{ 0x10212, 2, 20 },
+	{ 0x10324, 2, -20 },
+	{ 0x10312, 2, 20 },
+	{ 0x10424, 2, -20 },
+	{ 0x10412, 2, 20 },
+	{ 0x10524, 2, -20 },
+	{ 0x10512, 2, 20 },
+	{ 0x10624, 2, -20 },
+	{ 0x10612, 2, 20 },
+	{ 0x10724, 2, -20 },
+	{ 0x10712, 2, 20 },
+	{ 0x10824, 2, -20 },
+	{ 0x10812, 2, 20 },
+	{ 0x1005a, 7, 2 },
+	{ 0x1002a, 2, -2 },
+	{ 0x10015, 2, 11 },
+	{ 0x10025, 2, -20 },
+	{ 0x10013, 2, 20 },
+	{ 0x10125, 2, -20 },
+	{ 0x10113, 2, 20 },
+	{ 0x10225, 2, -20 },
+	{ 0x10213, 2, 20 },
+	{ 0x10325, 2, -20 },
+	{ 0x10313, 2, 20 },
+	{ 0x10425, 2, -20 },
+	{ 0x10413, 2, 20 },
+	{ 0x10525, 2, -20 },
+	{ 0x10513, 2, 20 },
+	{ 0x10625, 2, -20 },
+	{ 0x10613, 2, 20 },
+	{ 0x10725, 2, -20 },
+	{ 0x10713, 2, 20 },
+	{ 0x10825, 2, -20 },
+	{ 0x10813, 2, 20 },
+	{ 0x1005b, 7, 2 },
+	{ 0x1002b, 2, -2 },
+	{ 0x10016, 2, 11 },
+	{ 0x110024, 2, -20 },
+	{ 0x110012, 2, 20 },
+	{ 0x110124, 2, -20 },
+	{ 0x110112, 2, 20 },
+	{ 0x110224, 2, -20 },
+	{ 0x110212, 2, 20 },
+	{ 0x110324, 2, -20 },
+	{ 0x110312, 2, 20 },
+	{ 0x110424, 2, -20 },
+	{ 0x110412, 2, 20 },
+	{ 0x110524, 2, -20 },
+	{ 0x110512, 2, 20 },
+	{ 0x110624, 2, -20 },
+	{ 0x110612, 2, 20 },
+	{ 0x110724, 2, -20 },
+	{ 0x110712, 2, 20 },
+	{ 0x110824, 2, -20 },
+	{ 0x110812, 2, 20 },
+	{ 0x11005a, 7, 2 },
+	{ 0x11002a, 2, -2 },
+	{ 0x110015, 2, 11 },
+	{ 0x110025, 2, -20 },
+	{ 0x110013, 2, 20 },
+	{ 0x110125, 2, -20 },
+	{ 0x110113, 2, 20 },
+	{ 0x110225, 2, -20 },
+	{ 0x110213, 2, 20 },
+	{ 0x110325, 2, -20 },
+	{ 0x110313, 2, 20 },
+	{ 0x110425, 2, -20 },
+	{ 0x110413, 2, 20 },
+	{ 0x110525, 2, -20 },
+	{ 0x110513, 2, 20 },
+	{ 0x110625, 2, -20 },
+	{ 0x110613, 2, 20 },
+	{ 0x110725, 2, -20 },
+	{ 0x110713, 2, 20 },
+	{ 0x110825, 2, -20 },
+	{ 0x110813, 2, 20 },
+	{ 0x11005b, 7, 2 },
+	{ 0x11002b, 2, -2 },
+	{ 0x110016, 2, 11 },
+	{ 0x30000, 2, 3 },
+	{ 0x30004, 2, 3 },
+	{ 0x30037, 2, 177 },
+	{ 0x300e9, 1, 1 },
+	{ 0x130000, 2, 3 },
+	{ 0x130004, 2, 3 },
+	{ 0x130037, 2, 177 },
+	{ 0x1300e9, 1, 1 },
+	{ 0x3001a, 2, 70 },
+	{ 0x30080, 3, 1 },
+	{ 0x30084, 6, 1 },
+	{ 0x300a0, 4, 1 },
+	{ 0x300a6, 6, 1 },
+	{ 0x90803, 7, 1 },
+	{ 0x9080b, 5, 1 },
+	{ 0x90811, 15, 1 },
+	{ 0x90903, 2, 53 },
+	{ 0x9090b, 1, 1 },
+	{ 0x9002e, 1536, 1 },
+	{ 0x9001c, 18, 1 },
+	{ 0x90700, 9, 1 },
+	{ 0x9070c, 16, 1 },
+	{ 0x90820, 8, 1 },
+	{ 0x90900, 3, 1 },
+	{ 0x90904, 2, 1 },
+	{ 0x90908, 3, 1 },
+	{ 0x90920, 24, 1 },
+	{ 0x90940, 8, 1 },
+	{ 0x90986, 2, 1 },
+	{ 0x90c10, 16, 1 },
+	{ 0xc0000, 2, 6 },
+	{ 0xc0007, 2, -5 },
+	{ 0xc0003, 2, -2 },
+	{ 0xc0036, 2, 79 },
+	{ 0xc0088, 2, 120 },
+	{ 0xc0101, 2, 1 },
+	{ 0xc0104, 2, 1 },
+	{ 0xc0108, 26, 1 },
+	{ 0x70024, 8, 1 },
+	{ 0x70011, 2, 31 },
+	{ 0x70031, 15, 1 },
+	{ 0x70060, 6, 1 },
+	{ 0x700d2, 6, 1 },
+	{ 0x2000d, 2, 9 },
+	{ 0x20022, 2, 1 },
+	{ 0x20043, 2, 2 },
+	{ 0x20046, 2, -49 },
+	{ 0x20041, 2, -38 },
+	{ 0x20124, 96, 1 },
+	{ 0x2018b, 96, 1 },
+	{ 0x20018, 3, 4 },
+	{ 0x20025, 4, 1 },
+	{ 0x2002a, 2, 7 },
+	{ 0x20032, 3, 1 },
+	{ 0x20042, 2, 2 },
+	{ 0x20057, 2, 2 },
+	{ 0x20060, 2, 18 },
+	{ 0x20073, 2, 1 },
+	{ 0x20078, 3, 1 },
+	{ 0x2007e, 2, 34 },
+	{ 0x200a6, 3, 1 },
+	{ 0x200bd, 2, 3 },
+	{ 0x200c1, 2, 1 },
+	{ 0x200ef, 4, 1 },
+	{ 0x2011b, 4, 1 },
+	{ 0x20122, 2, 495 },
+	{ 0x1006c, 2, 1 },
+	{ 0x1006a, 2, 1 },
+	{ 0x10068, 2, 1 },
+	{ 0x1006e, 2, 1 },
+	{ 0x1001e, 2, 1 },
+	{ 0x1001c, 2, 1 },
+	{ 0x1016c, 2, 1 },
+	{ 0x1016a, 2, 1 },
+	{ 0x10168, 2, 1 },
+	{ 0x1016e, 2, 1 },
+	{ 0x1011e, 2, 1 },
+	{ 0x1011c, 2, 1 },
+	{ 0x1026c, 2, 1 },
+	{ 0x1026a, 2, 1 },
+	{ 0x10268, 2, 1 },
+	{ 0x1026e, 2, 1 },
+	{ 0x1021e, 2, 1 },
+	{ 0x1021c, 2, 1 },
+	{ 0x1036c, 2, 1 },
+	{ 0x1036a, 2, 1 },
+	{ 0x10368, 2, 1 },
+	{ 0x1036e, 2, 1 },
+	{ 0x1031e, 2, 1 },
+	{ 0x1031c, 2, 1 },
+	{ 0x1046c, 2, 1 },
+	{ 0x1046a, 2, 1 },
+	{ 0x10468, 2, 1 },
+	{ 0x1046e, 2, 1 },
+	{ 0x1041e, 2, 1 },
+	{ 0x1041c, 2, 1 },
+	{ 0x1056c, 2, 1 },
+	{ 0x1056a, 2, 1 },
+	{ 0x10568, 2, 1 },
+	{ 0x1056e, 2, 1 },
+	{ 0x1051e, 2, 1 },
+	{ 0x1051c, 2, 1 },
+	{ 0x1066c, 2, 1 },
+	{ 0x1066a, 2, 1 },
+	{ 0x10668, 2, 1 },
+	{ 0x1066e, 2, 1 },
+	{ 0x1061e, 2, 1 },
+	{ 0x1061c, 2, 1 },
+	{ 0x1076c, 2, 1 },
+	{ 0x1076a, 2, 1 },
+	{ 0x10768, 2, 1 },
+	{ 0x1076e, 2, 1 },
+	{ 0x1071e, 2, 1 },
+	{ 0x1071c, 2, 1 },
+	{ 0x1086c, 2, 1 },
+	{ 0x1086a, 2, 1 },
+	{ 0x10868, 2, 1 },
+	{ 0x1086e, 2, 1 },
+	{ 0x1081e, 2, 1 },
+	{ 0x1081c, 2, 1 },
+	{ 0x1000f, 2, 10 },
+	{ 0x1001b, 2, 7 },
+	{ 0x10023, 2, -34 },
+	{ 0x10005, 4, 2 },
+	{ 0x10017, 2, 1 },
+	{ 0x1002f, 2, 7 },
+	{ 0x10037, 2, 2 },
+	{ 0x1003d, 2, 7 },
+	{ 0x10045, 2, 7 },
+	{ 0x1004d, 2, 97 },
+	{ 0x100e8, 4, 1 },
+	{ 0x10002, 2, 8 },
+	{ 0x1001a, 2, 88 },
+	{ 0x10075, 2, 20 },
+	{ 0x1008a, 3, 1 },
+	{ 0x1008e, 2, 3 },
+	{ 0x10092, 6, 1 },
+	{ 0x1009e, 2, 4 },
+	{ 0x100a4, 2, 2 },
+	{ 0x100a7, 2, 1 },
+	{ 0x100ac, 2, 4 },
+	{ 0x100b1, 4, 1 },
+	{ 0x100b9, 3, 1 },
+	{ 0x100da, 2, 4 },
+	{ 0x100be, 2, -9 },
+	{ 0x100aa, 2, 276 },
+	{ 0x101b5, 2, -11 },
+	{ 0x108be, 2, -9 },
+	{ 0x108aa, 2, 1986 },
+	{ 0x1106d, 2, -3 },
+	{ 0x1106b, 2, -3 },
+	{ 0x11069, 2, 5 },
+	{ 0x1106f, 2, -81 },
+	{ 0x1101f, 2, -3 },
+	{ 0x1101d, 2, 335 },
+	{ 0x1186d, 2, -3 },
+	{ 0x1186b, 2, -3 },
+	{ 0x11869, 2, 5 },
+	{ 0x1186f, 2, -81 },
+	{ 0x1181f, 2, -3 },
+	{ 0x1181d, 2, -2062 },
+	{ 0x11019, 2, 2 },
+	{ 0x11022, 2, 1 },
+	{ 0x11001, 2, 4 },
+	{ 0x11007, 3, 2 },
+	{ 0x11017, 2, 1 },
+	{ 0x1102f, 2, 7 },
+	{ 0x11037, 2, 2 },
+	{ 0x1103d, 2, 7 },
+	{ 0x11045, 2, 7 },
+	{ 0x1104d, 2, 97 },
+	{ 0x110e8, 4, 1 },
+	{ 0x11106c, 2, 1 },
+	{ 0x11106a, 2, 1 },
+	{ 0x111068, 2, 1 },
+	{ 0x11106e, 2, 1 },
+	{ 0x11101e, 2, 1 },
+	{ 0x11101c, 2, 1 },
+	{ 0x11100f, 2, 10 },
+	{ 0x11101b, 2, 7 },
+	{ 0x111023, 2, -34 },
+	{ 0x111005, 4, 2 },
+	{ 0x111017, 2, 1 },
+	{ 0x11102f, 2, 7 },
+	{ 0x111037, 2, 2 },
+	{ 0x11103d, 2, 7 },
+	{ 0x111045, 2, 7 },
+	{ 0x11104d, 2, 97 },
+	{ 0x1110e8, 4, 1 },
+	{ 0x11002, 2, 8 },
+	{ 0x1101a, 2, 88 },
+	{ 0x11075, 2, 20 },
+	{ 0x1108a, 3, 1 },
+	{ 0x1108e, 2, 3 },
+	{ 0x11092, 6, 1 },
+	{ 0x1109e, 2, 4 },
+	{ 0x110a4, 2, 2 },
+	{ 0x110a7, 2, 1 },
+	{ 0x110ac, 2, 4 },
+	{ 0x110b1, 4, 1 },
+	{ 0x110b9, 3, 1 },
+	{ 0x110da, 2, 4 },
+	{ 0x110be, 2, -9 },
+	{ 0x110aa, 2, 276 },
+	{ 0x111b5, 2, -11 },
+	{ 0x118be, 2, -9 },
+	{ 0x118aa, 2, 1986 },
+	{ 0x1206d, 2, -3 },
+	{ 0x1206b, 2, -3 },
+	{ 0x12069, 2, 5 },
+	{ 0x1206f, 2, -81 },
+	{ 0x1201f, 2, -3 },
+	{ 0x1201d, 2, 335 },
+	{ 0x1286d, 2, -3 },
+	{ 0x1286b, 2, -3 },
+	{ 0x12869, 2, 5 },
+	{ 0x1286f, 2, -81 },
+	{ 0x1281f, 2, -3 },
+	{ 0x1281d, 2, -2062 },
+	{ 0x12019, 2, 2 },
+	{ 0x12022, 2, 1 },
+	{ 0x12001, 2, 4 },
+	{ 0x12007, 3, 2 },
+	{ 0x12017, 2, 1 },
+	{ 0x1202f, 2, 7 },
+	{ 0x12037, 2, 2 },
+	{ 0x1203d, 2, 7 },
+	{ 0x12045, 2, 7 },
+	{ 0x1204d, 2, 97 },
+	{ 0x120e8, 4, 1 },
+	{ 0x11206c, 2, 1 },
+	{ 0x11206a, 2, 1 },
+	{ 0x112068, 2, 1 },
+	{ 0x11206e, 2, 1 },
+	{ 0x11201e, 2, 1 },
+	{ 0x11201c, 2, 1 },
+	{ 0x11200f, 2, 10 },
+	{ 0x11201b, 2, 7 },
+	{ 0x112023, 2, -34 },
+	{ 0x112005, 4, 2 },
+	{ 0x112017, 2, 1 },
+	{ 0x11202f, 2, 7 },
+	{ 0x112037, 2, 2 },
+	{ 0x11203d, 2, 7 },
+	{ 0x112045, 2, 7 },
+	{ 0x11204d, 2, 97 },
+	{ 0x1120e8, 4, 1 },
+	{ 0x12002, 2, 8 },
+	{ 0x1201a, 2, 88 },
+	{ 0x12075, 2, 20 },
+	{ 0x1208a, 3, 1 },
+	{ 0x1208e, 2, 3 },
+	{ 0x12092, 6, 1 },
+	{ 0x1209e, 2, 4 },
+	{ 0x120a4, 2, 2 },
+	{ 0x120a7, 2, 1 },
+	{ 0x120ac, 2, 4 },
+	{ 0x120b1, 4, 1 },
+	{ 0x120b9, 3, 1 },
+	{ 0x120da, 2, 4 },
+	{ 0x120be, 2, -9 },
+	{ 0x120aa, 2, 276 },
+	{ 0x121b5, 2, -11 },
+	{ 0x128be, 2, -9 },
+	{ 0x128aa, 2, 1986 },
+	{ 0x1306d, 2, -3 },
+	{ 0x1306b, 2, -3 },
+	{ 0x13069, 2, 5 },
+	{ 0x1306f, 2, -81 },
+	{ 0x1301f, 2, -3 },
+	{ 0x1301d, 2, 335 },
+	{ 0x1386d, 2, -3 },
+	{ 0x1386b, 2, -3 },
+	{ 0x13869, 2, 5 },
+	{ 0x1386f, 2, -81 },
+	{ 0x1381f, 2, -3 },
+	{ 0x1381d, 2, -2062 },
+	{ 0x13019, 2, 2 },
+	{ 0x13022, 2, 1 },
+	{ 0x13001, 2, 4 },
+	{ 0x13007, 3, 2 },
+	{ 0x13017, 2, 1 },
+	{ 0x1302f, 2, 7 },
+	{ 0x13037, 2, 2 },
+	{ 0x1303d, 2, 7 },
+	{ 0x13045, 2, 7 },
+	{ 0x1304d, 2, 97 },
+	{ 0x130e8, 4, 1 },
+	{ 0x11306c, 2, 1 },
+	{ 0x11306a, 2, 1 },
+	{ 0x113068, 2, 1 },
+	{ 0x11306e, 2, 1 },
+	{ 0x11301e, 2, 1 },
+	{ 0x11301c, 2, 1 },
+	{ 0x11300f, 2, 10 },
+	{ 0x11301b, 2, 7 },
+	{ 0x113023, 2, -34 },
+	{ 0x113005, 4, 2 },
+	{ 0x113017, 2, 1 },
+	{ 0x11302f, 2, 7 },
+	{ 0x113037, 2, 2 },
+	{ 0x11303d, 2, 7 },
+	{ 0x113045, 2, 7 },
+	{ 0x11304d, 2, 97 },
+	{ 0x1130e8, 4, 1 },
+	{ 0x13002, 2, 8 },
+	{ 0x1301a, 2, 88 },
+	{ 0x13075, 2, 20 },
+	{ 0x1308a, 3, 1 },
+	{ 0x1308e, 2, 3 },
+	{ 0x13092, 6, 1 },
+	{ 0x1309e, 2, 4 },
+	{ 0x130a4, 2, 2 },
+	{ 0x130a7, 2, 1 },
+	{ 0x130ac, 2, 4 },
+	{ 0x130b1, 4, 1 },
+	{ 0x130b9, 3, 1 },
+	{ 0x130da, 2, 4 },
+	{ 0x130be, 2, -9 },
+	{ 0x130aa, 2, 276 },
+	{ 0x131b5, 2, -11 },
+	{ 0x138be, 2, -9 },
+	{ 0x138aa, 1, 1 },
+};
+
+static const struct ddrphy_csr_grp ddrphy_csr_grps[] = {
+	{ 3, 4, 0x1000 },
+	{ 3, 2, 0x1000 },
+	{ 57, 1, 0x0 },
+	{ 23, 4, 0x1000 },
+	{ 37, 1, 0x0 },
+	{ 23, 4, 0x1000 },
+	{ 6, 2, 0x1000 },
+	{ 84, 4, 0x1000 },
+	{ 13, 2, 0x1000 },
+	{ 5, 2, 0x100000 },
+	{ 7, 1, 0x0 },
+	{ 1, 3, 0x4 },
+	{ 12, 1, 0x0 },
+	{ 1, 9, 0x100 },
+	{ 4, 1, 0x0 },
+	{ 5, 2, 0x100000 },
+	{ 18, 1, 0x0 },
+	{ 65, 2, 0x100000 },
+	{ 13, 1, 0x0 },
+	{ 3, 4, 0x200 },
+	{ 2, 1, 0x0 },
+	{ 6, 8, 0x100 },
+	{ 17, 1, 0x0 },
+	{ 6, 9, 0x100 },
+	{ 24, 1, 0x0 },
+	{ 3, 4, 0x200 },
+	{ 2, 1, 0x0 },
+	{ 6, 8, 0x100 },
+	{ 17, 1, 0x0 },
+	{ 6, 9, 0x100 },
+	{ 24, 1, 0x0 },
+	{ 3, 4, 0x200 },
+	{ 2, 1, 0x0 },
+	{ 6, 8, 0x100 },
+	{ 17, 1, 0x0 },
+	{ 6, 9, 0x100 },
+	{ 24, 1, 0x0 },
+	{ 3, 4, 0x200 },
+	{ 2, 1, 0x0 },
+};
+#endif
@@ -0,0 +1,31 @@
+/* SPDX-License-Identifier: GPL-2.0+ */
+/*
+ * Copyright 2024 NXP
+ */
+#ifndef EDMA_H
+#define EDMA_H
+
+#include "asm/types.h"
+
+/* WAKEUP.EDMA5_MP3 base address: 4221_0000h */
+#define EDMA2_BASE_ADDR (0x42000000)
+
+/**
+ * Program channel 0 TCD of the eDMA at dma_base_addr
+ *
+ * size: bytes per minor loop (one minor loop per start request)
+ * src_width/dst_width: data width of each read/write (unit is byte)
+ * src_off/dst_off: address increment after each read/write (unit is byte)
+ * iter: major loop count
+ */
+int edma_set(unsigned int dma_base_addr, unsigned int src_addr, unsigned int src_width,
+	     int src_off, unsigned int dst_addr, unsigned int dst_width, int dst_off,
+	     unsigned int size, unsigned int iter);
+void edma_start(unsigned int dma_base_addr);
+/* Wait for the channel to go inactive, -1 on transfer error */
+int edma_check(unsigned int dma_base_addr);
+/* Wait for the major loop to complete, -1 on transfer error */
+int edma_wait(unsigned int dma_base_addr);
+void edma_clr(unsigned int dma_base_addr);
+
+#endif
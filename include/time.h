@@ -13,6 +13,10 @@ uint64_t timer_tick(void);
 uint32_t timer_get_us(void);
 bool time_after(uint32_t us, uint32_t timeout);
 void udelay(uint32_t us);
+/* CPU cycle counter, for profiling and short delays */
+void timer_calibrate(void);
+uint32_t timer_get_cycles(void);
+uint32_t timer_cycles_to_ns(uint32_t cycles);
 
 #define mdelay(x)	udelay(1000 * x)
 
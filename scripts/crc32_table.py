@@ -0,0 +1,92 @@
+#!/usr/bin/env python3
+# SPDX-License-Identifier: GPL-2.0+
+#
+# Copyright 2024 NXP
+#
+# Generator of the slicing-by-N tables crc32_update() (source/utils/crc.c)
+# uses with CRC_SLICE=4/8 builds. Table 0 is the byte table of the
+# reflected polynomial 0xEDB88320, table k advances a byte k further:
+#
+#   t[k][n] = (t[k - 1][n] >> 8) ^ t[0][t[k - 1][n] & 0xff]
+#
+# A model of the slicing loop is checked against zlib.crc32 on a set of
+# vectors, aligned and not, before the tables are written.
+
+import argparse
+import sys
+import zlib
+
+POLY = 0xedb88320
+VECTORS = [b'', b'a', b'123456789', bytes(range(256)) * 3, b'\xff' * 61,
+           b'The quick brown fox jumps over the lazy dog']
+
+
+def tables(slices):
+    t = [[0] * 256 for _ in range(slices)]
+    for n in range(256):
+        c = n
+        for _ in range(8):
+            c = (c >> 1) ^ (POLY if c & 1 else 0)
+        t[0][n] = c
+    for k in range(1, slices):
+        for n in range(256):
+            t[k][n] = (t[k - 1][n] >> 8) ^ t[0][t[k - 1][n] & 0xff]
+    return t
+
+
+def crc32_slice(t, crc, data, head):
+    """Mirror of crc32_update(), head bytes are processed before the words."""
+    slices = len(t)
+    crc ^= 0xffffffff
+    i = 0
+    while i < len(data) and i < head:
+        crc = t[0][(crc ^ data[i]) & 0xff] ^ (crc >> 8)
+        i += 1
+    while len(data) - i >= slices:
+        lo = crc ^ int.from_bytes(data[i:i + 4], 'little')
+        hi = int.from_bytes(data[i + 4:i + slices], 'little')
+        crc = 0
+        for b in range(slices):
+            v = (lo >> (8 * b)) if b < 4 else (hi >> (8 * (b - 4)))
+            crc ^= t[slices - 1 - b][v & 0xff]
+        i += slices
+    while i < len(data):
+        crc = t[0][(crc ^ data[i]) & 0xff] ^ (crc >> 8)
+        i += 1
+    return crc ^ 0xffffffff
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Generate the CRC-32 slicing tables')
+    parser.add_argument('-n', '--slices', type=int, choices=(4, 8), required=True,
+                        help='bytes processed per step')
+    parser.add_argument('-o', '--output', required=True, help='generated header')
+    args = parser.parse_args()
+
+    t = tables(args.slices)
+    for vec in VECTORS:
+        for head in range(4):
+            if crc32_slice(t, 0, vec, head) != zlib.crc32(vec):
+                sys.exit('error: slicing-by-%d CRC-32 does not match zlib' % args.slices)
+        half = len(vec) // 2
+        if crc32_slice(t, crc32_slice(t, 0, vec[:half], 0), vec[half:], 1) != zlib.crc32(vec):
+            sys.exit('error: slicing-by-%d CRC-32 does not chain' % args.slices)
+
+    with open(args.output, 'w') as f:
+        f.write('/* Generated by scripts/crc32_table.py, do not edit */\n')
+        f.write('#ifndef CRC32_TABLE_H\n#define CRC32_TABLE_H\n')
+        f.write('#include "asm/types.h"\n\n')
+        f.write('#define CRC32_TABLE_SLICES\t%d\n\n' % args.slices)
+        f.write('#if CRC32_TABLE_SLICES != CONFIG_CRC32_SLICE\n')
+        f.write('#error "crc32_table.h does not match CONFIG_CRC32_SLICE"\n#endif\n\n')
+        f.write('static const u32 crc32_table[%d][256] = {\n' % args.slices)
+        for k in range(args.slices):
+            f.write('\t{\n')
+            for n in range(0, 256, 4):
+                f.write('\t\t%s,\n' % ', '.join('0x%08x' % v for v in t[k][n:n + 4]))
+            f.write('\t},\n')
+        f.write('};\n#endif\n')
+
+
+if __name__ == '__main__':
+    main()
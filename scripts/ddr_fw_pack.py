@@ -0,0 +1,140 @@
+#!/usr/bin/env python3
+# SPDX-License-Identifier: GPL-2.0+
+#
+# Copyright 2024 NXP
+#
+# Host packer for the compressed DDR PHY training firmware container that
+# ddr_load_train_firmware() (source/ddr/helper.c) decodes straight into
+# PHY SRAM. The container replaces the plain {imem_size, dmem_size} header
+# and images appended after the OEI image:
+#
+#   u32 magic ("DWLZ"), imem_size, dmem_size, imem_lz_size, dmem_lz_size
+#   IMEM LZ stream, DMEM LZ stream
+#
+# Each stream is made of halfwords: a flags halfword announces the next
+# 16 items LSB first, a clear bit is a literal halfword and a set bit a
+# match halfword copying ([15:8] + 2) halfwords from ([7:0] + 1) back.
+
+import argparse
+import struct
+import sys
+import time
+
+DDR_FW_LZ_MAGIC = 0x5a4c5744
+DDR_FW_LZ_WIN = 256
+MATCH_MIN = 2
+MATCH_MAX = 0xff + MATCH_MIN
+
+
+def halfwords(data):
+    if len(data) % 2:
+        data += b'\0'
+    return list(struct.unpack('<%dH' % (len(data) // 2), data))
+
+
+def lz_pack(src):
+    """Greedy LZ encoding of a halfword list, returns (stream, matches)."""
+    out = []
+    items = []
+    heads = {}
+    matches = 0
+    i = 0
+    while i < len(src):
+        best_len = best_dist = 0
+        if i + 1 < len(src):
+            for j in reversed(heads.get((src[i], src[i + 1]), ())):
+                if i - j > DDR_FW_LZ_WIN:
+                    break
+                n = 0
+                while (n < MATCH_MAX and i + n < len(src) and
+                       src[j + n] == src[i + n]):
+                    n += 1
+                if n > best_len:
+                    best_len, best_dist = n, i - j
+                    if n == MATCH_MAX:
+                        break
+        if best_len >= MATCH_MIN:
+            items.append((1, ((best_len - MATCH_MIN) << 8) | (best_dist - 1)))
+            matches += 1
+            step = best_len
+        else:
+            items.append((0, src[i]))
+            step = 1
+        for k in range(i, i + step):
+            if k + 1 < len(src):
+                chain = heads.setdefault((src[k], src[k + 1]), [])
+                chain.append(k)
+                # only the last window of positions can be referenced
+                if len(chain) > 2 * DDR_FW_LZ_WIN:
+                    del chain[:DDR_FW_LZ_WIN]
+        i += step
+
+    for n in range(0, len(items), 16):
+        group = items[n:n + 16]
+        out.append(sum(bit << b for b, (bit, _) in enumerate(group)))
+        out.extend(val for _, val in group)
+    return out, matches
+
+
+def lz_unpack(stream, num):
+    """Mirror of ddr_fw_lz_unpack()."""
+    out = []
+    pos = 0
+    flags = 1
+    while len(out) < num:
+        if flags == 1:
+            flags = stream[pos] | 0x10000
+            pos += 1
+        if flags & 1:
+            tok = stream[pos]
+            pos += 1
+            length, dist = (tok >> 8) + MATCH_MIN, (tok & 0xff) + 1
+            for _ in range(length):
+                if len(out) == num:
+                    break
+                out.append(out[-dist])
+        else:
+            out.append(stream[pos])
+            pos += 1
+        flags >>= 1
+    return out
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Pack the DDR PHY training firmware')
+    parser.add_argument('imem', help='IMEM image')
+    parser.add_argument('dmem', help='DMEM image')
+    parser.add_argument('-o', '--output', required=True, help='firmware container')
+    parser.add_argument('--stats', action='store_true',
+                        help='print compression ratio and decode work per image')
+    args = parser.parse_args()
+
+    sizes = []
+    streams = []
+    for name in (args.imem, args.dmem):
+        with open(name, 'rb') as f:
+            img = halfwords(f.read())
+        start = time.time()
+        stream, matches = lz_pack(img)
+        elapsed = time.time() - start
+        if lz_unpack(stream, len(img)) != img:
+            sys.exit('error: %s: LZ stream does not round-trip' % name)
+        sizes.append(2 * len(img))
+        streams.append(stream)
+        if args.stats:
+            # the plain loader does one readw per halfword, the decoder one
+            # per literal, match and flags halfword
+            print('%s: %d -> %d bytes (%.1f%%), %d matches, %d source reads '
+                  'instead of %d, packed in %.1f s' %
+                  (name, 2 * len(img), 2 * len(stream), 200.0 * len(stream) / max(sizes[-1], 1),
+                   matches, len(stream), len(img), elapsed))
+
+    with open(args.output, 'wb') as f:
+        f.write(struct.pack('<5I', DDR_FW_LZ_MAGIC, sizes[0], sizes[1],
+                            2 * len(streams[0]), 2 * len(streams[1])))
+        for stream in streams:
+            f.write(struct.pack('<%dH' % len(stream), *stream))
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,160 @@
+#!/usr/bin/env python3
+# SPDX-License-Identifier: GPL-2.0+
+#
+# Copyright 2024 NXP
+#
+# Encoder for the QuickBoot CSR save list, run by make qb-csr. The flat
+# list of PHY addresses ddrphy_csr_cfg[] (include/ddr/qb_p230_rldb4.h) is
+# converted to the range encoded tables ddrphy_qb_save() walks (see ddrphy_csr_run and
+# ddrphy_csr_grp in include/ddr.h):
+#
+#   runs: base, count, stride, i.e. count addresses base + i * stride
+#   groups: runs, inst, inst_stride, i.e. the next runs runs repeated for
+#           inst instances, each one inst_stride above the previous one
+#
+# The PHY registers of each DBYTE/ACX4 lane are listed in the same order,
+# a lane group is then stored once. The expansion of the encoded tables is
+# checked against the flat list before they are written.
+#
+# DDRPHY_QB_CSR_HASH, the CRC-32 of the flat list as little endian words,
+# is recorded in the QuickBoot state header: a state saved with another
+# CSR list is rejected before its sections are read.
+
+import argparse
+import re
+import struct
+import sys
+import zlib
+
+LIST_RE = re.compile(r'ddrphy_csr_cfg\[\w*\] = \{(.*?)\};', re.S)
+ADDR_RE = re.compile(r'0x[0-9a-fA-F]+|\d+')
+
+COUNT_MAX = 0xffff
+STRIDE_MIN, STRIDE_MAX = -0x8000, 0x7fff
+# runs of a group tried for repeats
+GROUP_MAX = 128
+
+
+def load_list(name):
+    with open(name) as f:
+        m = LIST_RE.search(f.read())
+    if not m:
+        sys.exit('error: %s: no ddrphy_csr_cfg list' % name)
+    return [int(a, 0) for a in ADDR_RE.findall(m.group(1))]
+
+
+def encode_runs(addrs):
+    """Split the list into arithmetic runs of (base, count, stride)."""
+    runs = []
+    i = 0
+    while i < len(addrs):
+        count, stride = 1, 1
+        if i + 1 < len(addrs):
+            step = addrs[i + 1] - addrs[i]
+            j = i + 1
+            while (j < len(addrs) and addrs[j] - addrs[j - 1] == step and
+                   j - i < COUNT_MAX):
+                j += 1
+            if step and STRIDE_MIN <= step <= STRIDE_MAX:
+                count, stride = j - i, step
+        runs.append((addrs[i], count, stride))
+        i += count
+    return runs
+
+
+def repeat(runs, p, k):
+    """Instances of runs[p:p + k] repeated at a constant stride from p."""
+    if p + k >= len(runs):
+        return 1, 0
+    stride = runs[p + k][0] - runs[p][0]
+    n = 1
+    while p + (n + 1) * k <= len(runs):
+        if any(runs[p + n * k + t] != (runs[p + t][0] + n * stride,) + runs[p + t][1:]
+               for t in range(k)):
+            break
+        n += 1
+    return n, stride
+
+
+def encode_groups(runs):
+    """Greedy grouping, returns the stored runs and (runs, inst, inst_stride)."""
+    stored = []
+    groups = []
+    plain = None
+    p = 0
+    while p < len(runs):
+        best = (1, 1, 0)
+        for k in range(1, min(GROUP_MAX, len(runs) - p) + 1):
+            n, stride = repeat(runs, p, k)
+            if n > 1 and stride and n * k > best[0] * best[1]:
+                best = (k, n, stride)
+        k, n, stride = best
+        # a repeated group saves (n - 1) * k runs for one group entry
+        if (n - 1) * k > 1:
+            stored.extend(runs[p:p + k])
+            groups.append([k, n, stride])
+            plain = None
+            p += k * n
+            continue
+        # runs that do not repeat are gathered in single instance groups
+        if plain is None:
+            plain = [0, 1, 0]
+            groups.append(plain)
+        stored.append(runs[p])
+        plain[0] += 1
+        p += 1
+    return stored, groups
+
+
+def expand(runs, groups):
+    """Mirror of ddrphy_csr_next()."""
+    addrs = []
+    r = 0
+    for k, n, inst_stride in groups:
+        for inst in range(n):
+            for base, count, stride in runs[r:r + k]:
+                addrs.extend(base + inst * inst_stride + i * stride for i in range(count))
+        r += k
+    return addrs
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Range encode the QuickBoot CSR save list')
+    parser.add_argument('input', help='header defining ddrphy_csr_cfg[]')
+    parser.add_argument('-o', '--output', required=True, help='generated header')
+    parser.add_argument('--stats', action='store_true', help='print the table sizes')
+    args = parser.parse_args()
+
+    addrs = load_list(args.input)
+    runs, groups = encode_groups(encode_runs(addrs))
+    if expand(runs, groups) != addrs:
+        sys.exit('error: %s: encoded CSR list does not expand to ddrphy_csr_cfg' % args.input)
+    if any(k > COUNT_MAX or n > COUNT_MAX for k, n, _ in groups):
+        sys.exit('error: %s: CSR list group out of range' % args.input)
+
+    with open(args.output, 'w') as f:
+        f.write('/* Generated by scripts/ddr_qb_csr.py from %s, do not edit */\n' % args.input)
+        f.write('#ifndef DDRPHY_QB_CSR_H\n#define DDRPHY_QB_CSR_H\n')
+        f.write('#include "ddr.h"\n\n')
+        f.write('#if DDRPHY_QB_CSR_SIZE != %d\n' % len(addrs))
+        f.write('#error "ddrphy_csr_cfg does not match DDRPHY_QB_CSR_SIZE"\n#endif\n\n')
+        f.write('#define DDRPHY_QB_CSR_HASH\t0x%08x\n\n' %
+                zlib.crc32(struct.pack('<%dI' % len(addrs), *addrs)))
+        f.write('static const struct ddrphy_csr_run ddrphy_csr_runs[] = {\n')
+        for base, count, stride in runs:
+            f.write('\t{ 0x%05x, %d, %d },\n' % (base, count, stride))
+        f.write('};\n\n')
+        f.write('static const struct ddrphy_csr_grp ddrphy_csr_grps[] = {\n')
+        for k, n, inst_stride in groups:
+            f.write('\t{ %d, %d, %s0x%x },\n' % (k, n, '-' if inst_stride < 0 else '',
+                                               abs(inst_stride)))
+        f.write('};\n#endif\n')
+
+    if args.stats:
+        print('%d CSRs: %d bytes -> %d runs, %d groups, %d bytes' %
+              (len(addrs), 4 * len(addrs), len(runs), len(groups),
+               8 * len(runs) + 8 * len(groups)))
+
+
+if __name__ == '__main__':
+    main()
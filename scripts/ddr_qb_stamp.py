@@ -0,0 +1,122 @@
+#!/usr/bin/env python3
+# SPDX-License-Identifier: GPL-2.0+
+#
+# Copyright 2024 NXP
+#
+# Writes a QuickBoot state saved by a training-only ddr oei image to a
+# state slot of a QuickBoot image (see ddrphy_qb_hdr in include/ddr.h).
+#
+# A training-only image does not see the slots and saves its state with
+# generation DDRPHY_QB_GEN_NONE and slot DDRPHY_QB_SLOT_NONE. The slots
+# of the image are checked like QuickBoot does from their headers: the
+# state gets the generation after the newest committed one and the slot
+# not holding it, then its header CRC and commit word are updated. A
+# state already stamped by a QBOOT=auto image is written to its slot.
+#
+#   state.bin: memory dump of QB_STATE_MEM, header.size + 4 bytes at least
+#   --offset:  offset of slot 0 in the image, after the PHY firmware
+#   --slot-size: DDRPHY_QB_SLOT_SIZE of the QuickBoot image build
+
+import argparse
+import struct
+import sys
+import zlib
+
+DDRPHY_QB_MAGIC = 0x42514444
+DDRPHY_QB_FSP_MAX = 4
+DDRPHY_QB_SLOTS = 2
+DDRPHY_QB_GEN_NONE = 0
+DDRPHY_QB_SLOT_NONE = 0xffffffff
+
+# magic, version, flags, ddr_type, fsp_num, drate[], csr_hash, gen, slot,
+# size, sect[] {offset, size, crc}, crc
+HDR_FMT = '<IHHII%dIIIII12II' % DDRPHY_QB_FSP_MAX
+HDR_SIZE = struct.calcsize(HDR_FMT)
+GEN, SLOT, SIZE = 10, 11, 12
+# fields a slot has to share with the state: version to csr_hash
+MATCH = slice(1, 10)
+
+
+def parse(data):
+    """Header fields of a committed state at data, None otherwise."""
+    if len(data) < HDR_SIZE:
+        return None
+    hdr = list(struct.unpack_from(HDR_FMT, data))
+    if hdr[0] != DDRPHY_QB_MAGIC or zlib.crc32(data[:HDR_SIZE - 4]) != hdr[-1]:
+        return None
+    size = hdr[SIZE]
+    if size < HDR_SIZE or size + 4 > len(data):
+        return None
+    if struct.unpack_from('<I', data, size)[0] != hdr[-1] ^ 0xffffffff:
+        return None
+    return hdr
+
+
+def newer(a, b):
+    """Generation a is newer than b, generations wrap around."""
+    return 0 < ((a - b) & 0xffffffff) < 0x80000000
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Write a QuickBoot state to an image slot')
+    parser.add_argument('state', help='QuickBoot state saved by the training flow')
+    parser.add_argument('image', help='QuickBoot image, updated in place')
+    parser.add_argument('--offset', type=lambda x: int(x, 0), required=True,
+                        help='offset of slot 0 in the image')
+    parser.add_argument('--slot-size', type=lambda x: int(x, 0), required=True,
+                        help='DDRPHY_QB_SLOT_SIZE of the QuickBoot image')
+    parser.add_argument('-n', '--dry-run', action='store_true',
+                        help='only print the slot and generation the state gets')
+    args = parser.parse_args()
+
+    with open(args.state, 'rb') as f:
+        state = bytearray(f.read())
+    hdr = parse(state)
+    if hdr is None:
+        sys.exit('error: %s: no committed QuickBoot state' % args.state)
+    state = state[:hdr[SIZE] + 4]
+    if len(state) > args.slot_size:
+        sys.exit('error: %d bytes state does not fit a %d bytes slot' %
+                 (len(state), args.slot_size))
+
+    with open(args.image, 'rb') as f:
+        image = bytearray(f.read())
+
+    if hdr[GEN] == DDRPHY_QB_GEN_NONE:
+        newest = None
+        for i in range(DDRPHY_QB_SLOTS):
+            base = args.offset + i * args.slot_size
+            slot = parse(image[base:base + args.slot_size])
+            # states QuickBoot rejects from their header are free slots
+            if (slot is None or slot[SLOT] != i or slot[GEN] == DDRPHY_QB_GEN_NONE or
+                    slot[MATCH] != hdr[MATCH]):
+                continue
+            if newest is None or newer(slot[GEN], newest[GEN]):
+                newest = slot
+        if newest is None:
+            hdr[GEN], hdr[SLOT] = 1, 0
+        else:
+            hdr[GEN] = (newest[GEN] + 1) & 0xffffffff or 1
+            hdr[SLOT] = (newest[SLOT] + 1) % DDRPHY_QB_SLOTS
+        struct.pack_into(HDR_FMT, state, 0, *hdr)
+        hdr[-1] = zlib.crc32(state[:HDR_SIZE - 4])
+        struct.pack_into(HDR_FMT, state, 0, *hdr)
+        struct.pack_into('<I', state, hdr[SIZE], hdr[-1] ^ 0xffffffff)
+    elif hdr[SLOT] >= DDRPHY_QB_SLOTS:
+        sys.exit('error: %s: slot %d out of range' % (args.state, hdr[SLOT]))
+
+    print('%s: %d bytes state, generation %d, slot %d' %
+          (args.image, len(state), hdr[GEN], hdr[SLOT]))
+    if args.dry_run:
+        return
+
+    base = args.offset + hdr[SLOT] * args.slot_size
+    if len(image) < base:
+        image += bytes(base - len(image))
+    image[base:base + len(state)] = state
+    with open(args.image, 'wb') as f:
+        f.write(image)
+
+
+if __name__ == '__main__':
+    main()
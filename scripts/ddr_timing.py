@@ -0,0 +1,470 @@
+#!/usr/bin/env python3
+# SPDX-License-Identifier: GPL-2.0+
+#
+# Copyright 2024 NXP
+#
+# Build-time converter for the DDR Tool generated board timing files.
+#
+# The board timing file is parsed and re-emitted for one DDR flow: tables
+# the flow never uses are dropped together with their references in the
+# timing descriptors, so that --gc-sections can discard them. Optionally
+# the PHY tables that ddrphy_cfg_set() consumes are converted to the
+# BURST/FILL register sequence stream described in include/ddr.h, which
+# ddr_seq_run() executes. With --reset-db, writes that only restore the
+# hardware reset value of a register are elided. With --coalesce, PHY
+# writes overwritten later with no firmware run in between are removed.
+
+import argparse
+import re
+import sys
+
+TABLE_RE = re.compile(r'^(/\*[^\n]*\*/\n)?'
+                      r'static struct (ddrc_cfg_param|ddrphy_cfg_param) (\w+)\[\] = \{\n'
+                      r'(.*?)^\};\n\n?', re.S | re.M)
+ENTRY_RE = re.compile(r'\{\s*(0x[0-9a-fA-F]+|\d+)\s*,\s*(0x[0-9a-fA-F]+|\d+)\s*\}')
+RESET_RE = re.compile(r'^(\w+)\s+(0x[0-9a-fA-F]+|\d+)(?:-(0x[0-9a-fA-F]+|\d+))?\s+(0x[0-9a-fA-F]+|\d+)$')
+FIELD_RE = re.compile(r'\.(\w+)\s*=\s*(\w+)\s*,')
+DRATE_RE = re.compile(r'\.drate\s*=')
+TIMING_RE = re.compile(r'^struct dram_timing_info \w+ = \{\n(.*?)^\};', re.S | re.M)
+FIELD_LINE_RE = r'^[ \t]*\.%s(?:_num)?\s*=\s*(?:ARRAY_SIZE\()?%s\)?\s*,[ \t]*\n'
+
+# dram_timing_info/dram_fsp_msg fields whose tables go through ddrphy_cfg_set()
+PHY_CFG_FIELDS = ('ddrphy_cfg', 'fsp_phy_cfg', 'fsp_phy_pie_cfg', 'ddrphy_pie')
+
+# dram_timing_info/dram_fsp_cfg field whose tables go through ddrc_config()
+DDRC_CFG_FIELDS = ('ddrc_cfg',)
+
+# register blocks of the reset value database and their address stride
+RESET_DB_BLOCKS = {'ddrc': 4, 'ddrphy': 1}
+
+# PHY registers whose writes have side effects or change how the writes
+# after them are decoded: never coalesced, and no write is coalesced
+# across them
+PHY_BARRIER_REGS = (
+    0xc0080,	# UcclkHclkEnables
+    0xc0086,	# ArcPmuEccCtl
+    0xd0000,	# MicroContMuxSel
+    0xd0031,	# DctWriteProt
+    0xd0099,	# MicroReset
+    0x20060,	# MemResetL
+    0x20090,	# PtrInit trigger
+    0x9080d,	# written repeatedly by the DDR Tool in fsp_phy_cfg
+)
+# training firmware IMEM/DMEM
+PHY_SRAM = range(0x50000, 0x60000)
+
+# dram_timing_info/dram_fsp_msg fields each DDR flow never dereferences
+FLOW_UNUSED_FIELDS = {
+    'train': ('ddrphy_trained_csr', 'fsp_phy_prog_csr_ps_cfg'),
+    'auto': ('ddrphy_trained_csr', 'fsp_phy_prog_csr_ps_cfg'),
+    'qb': ('ddrphy_cfg', 'fsp_phy_cfg', 'fsp_phy_pie_cfg', 'ddrphy_pie',
+           'ddrphy_trained_csr', 'fsp_phy_prog_csr_ps_cfg'),
+}
+
+DDR_SEQ_BURST = 0x0
+DDR_SEQ_FILL = 0x1
+DDRPHY_RUN_MAX = 0xff
+DDRPHY_ADDR_MAX = 0xfffff
+
+# a fill run pays off from this many equal consecutive values onwards
+FILL_MIN = 3
+
+
+class Table:
+    def __init__(self, comment, ctype, name, entries, span):
+        self.comment = comment
+        self.ctype = ctype
+        self.name = name
+        self.entries = entries
+        self.span = span
+        self.runs = None
+        self.dropped = False
+        self.modified = False
+        self.writes = len(entries)
+        self.elided = 0
+        self.coalesced = 0
+
+    def entry_size(self):
+        # struct ddrc_cfg_param is 8 bytes, packed ddrphy_cfg_param is 6 bytes
+        return 8 if self.ctype == 'ddrc_cfg_param' else 6
+
+    def raw_size(self):
+        return self.writes * self.entry_size()
+
+    def size(self):
+        if self.dropped:
+            return 0
+        if self.runs is None:
+            return len(self.entries) * self.entry_size()
+        return 2 * sum(2 + len(vals) for _, _, vals in self.runs)
+
+
+def parse(src):
+    tables = {}
+    for m in TABLE_RE.finditer(src):
+        comment, ctype, name, body = m.groups()
+        entries = [(int(e.group(1), 0), int(e.group(2), 0), e.group(0))
+                   for e in ENTRY_RE.finditer(body)]
+        tables[name] = Table(comment, ctype, name, entries, m.span())
+
+    # table names per field, in descriptor (and so execution) order
+    fields = {}
+    for field, name in FIELD_RE.findall(src):
+        if name in tables and name not in fields.get(field, []):
+            fields.setdefault(field, []).append(name)
+
+    return tables, fields
+
+
+def split_runs(entries):
+    """Split a (reg, val) list into runs of consecutive APB addresses."""
+    runs = []
+    for reg, val, _ in entries:
+        if reg > DDRPHY_ADDR_MAX:
+            sys.exit('error: PHY address 0x%x out of range' % reg)
+        if runs and reg == runs[-1][0] + len(runs[-1][1]) and len(runs[-1][1]) < DDRPHY_RUN_MAX:
+            runs[-1][1].append(val)
+        else:
+            runs.append((reg, [val]))
+    return runs
+
+
+def encode_runs(entries):
+    """Return [(op, reg, vals)] with fill runs split out of the bursts."""
+    out = []
+    for base, vals in split_runs(entries):
+        i = 0
+        while i < len(vals):
+            j = i
+            while j < len(vals) and vals[j] == vals[i]:
+                j += 1
+            if j - i >= FILL_MIN:
+                out.append((DDR_SEQ_FILL, base + i, [vals[i]] * (j - i)))
+                i = j
+                continue
+            # extend the burst up to the next fill candidate
+            k = i + 1
+            while k < len(vals):
+                m = k
+                while m < len(vals) and vals[m] == vals[k]:
+                    m += 1
+                if m - k >= FILL_MIN:
+                    break
+                k = m
+            out.append((DDR_SEQ_BURST, base + i, list(vals[i:k])))
+            i = k
+    return out
+
+
+def decode_runs(runs):
+    """Expand runs back into (reg, val) writes, as ddrphy_cfg_set() does."""
+    out = []
+    for _, reg, vals in runs:
+        out.extend((reg + i, v) for i, v in enumerate(vals))
+    return out
+
+
+def emit_runs(table):
+    lines = []
+    if table.comment:
+        lines.append(table.comment.rstrip('\n'))
+    lines.append('static ddrphy_cfg_tbl %s[] = {' % table.name)
+    for op, reg, vals in table.runs:
+        if op == DDR_SEQ_FILL:
+            lines.append('    DDRPHY_FILL(0x%x, %d), 0x%x,' % (reg, len(vals), vals[0]))
+            continue
+        lines.append('    DDRPHY_BURST(0x%x, %d),' % (reg, len(vals)))
+        for i in range(0, len(vals), 8):
+            lines.append('        ' + ' '.join('0x%x,' % v for v in vals[i:i + 8]))
+    lines.append('};')
+    return '\n'.join(lines) + '\n\n'
+
+
+def emit_entries(table):
+    lines = []
+    if table.comment:
+        lines.append(table.comment.rstrip('\n'))
+    lines.append('static struct %s %s[] = {' % (table.ctype, table.name))
+    lines.extend('    %s,' % text for _, _, text in table.entries)
+    lines.append('};')
+    return '\n'.join(lines) + '\n\n'
+
+
+def load_reset_db(path):
+    """Return {block: {reg: reset value}} from a reset value database."""
+    db = {block: {} for block in RESET_DB_BLOCKS}
+    with open(path) as f:
+        for num, line in enumerate(f, 1):
+            line = line.split('#')[0].strip()
+            if not line:
+                continue
+            m = RESET_RE.match(line)
+            if not m or m.group(1) not in RESET_DB_BLOCKS:
+                sys.exit('%s:%d: error: malformed reset value entry' % (path, num))
+            block, first, last, val = m.groups()
+            first = int(first, 0)
+            last = int(last, 0) if last else first
+            for reg in range(first, last + 1, RESET_DB_BLOCKS[block]):
+                db[block][reg] = int(val, 0)
+    return db
+
+
+def elide_resets(tables, seq, resets):
+    """
+    Drop the writes of the table sequence seq that restore a reset value.
+
+    seq lists the tables in the order they are applied after reset, with
+    no firmware run in between: a register only still holds its reset
+    value until its first write, so later writes are always kept.
+    """
+    written = set()
+    for name in seq:
+        t = tables[name]
+        if t.dropped:
+            continue
+        kept = []
+        for reg, val, text in t.entries:
+            if reg not in written and resets.get(reg) == val:
+                t.elided += 1
+                continue
+            written.add(reg)
+            kept.append((reg, val, text))
+        if len(kept) != len(t.entries):
+            t.entries = kept
+            t.modified = True
+            # zero sized arrays are not C99, unlink empty tables instead
+            if not kept:
+                t.dropped = True
+
+
+def phy_segments(fields):
+    """
+    Split the PHY tables ddr_cfg_phy() applies into segments delimited by
+    the training firmware runs and the PState "DMA reload" at the start of
+    each FSP PHY config: ddrphy_cfg, fsp_phy_cfg[0], run, fsp_phy_pie_cfg[0],
+    reload, fsp_phy_cfg[1], run, ..., fsp_phy_pie_cfg[n - 1], ddrphy_pie.
+    With more than 2 PStates the reload snapshots the PState registers,
+    fsp_phy_pie_cfg[i] included, before fsp_phy_cfg[i + 1] rewrites them.
+    """
+    segments = []
+    cfg = fields.get('fsp_phy_cfg', [])
+    pie = fields.get('fsp_phy_pie_cfg', [])
+    for i, name in enumerate(cfg):
+        segments.append(([] if i else list(fields.get('ddrphy_cfg', []))) + [name])
+        segments.append(pie[i:i + 1])
+    if not segments:
+        segments.append(list(fields.get('ddrphy_cfg', [])))
+    segments[-1] += fields.get('ddrphy_pie', [])
+    return segments
+
+
+def phy_states(tables, seg, entries):
+    """Register values at each barrier write and at the end of segment seg."""
+    states = []
+    regs = {}
+    for name in seg:
+        if tables[name].dropped:
+            continue
+        for reg, val, _ in entries[name]:
+            regs[reg] = val
+            if reg in PHY_BARRIER_REGS:
+                states.append(dict(regs))
+    states.append(regs)
+    return states
+
+
+def coalesce(tables, segments):
+    """
+    Remove the writes overwritten later in the same segment. Tables the
+    flow applies more than once are only kept as later writers.
+    Returns [(segment, table, index, reg, val, later table, later val)].
+    """
+    refs = {}
+    for seg in segments:
+        for name in seg:
+            refs[name] = refs.get(name, 0) + 1
+
+    orig = {name: list(t.entries) for name, t in tables.items()}
+    diff = []
+    for num, seg in enumerate(segments):
+        later = {}
+        for name in reversed(seg):
+            t = tables[name]
+            if t.dropped:
+                continue
+            kept = []
+            for idx in range(len(t.entries) - 1, -1, -1):
+                reg, val, text = t.entries[idx]
+                if reg in PHY_BARRIER_REGS:
+                    later = {}
+                elif reg in later and reg not in PHY_SRAM and refs[name] == 1:
+                    diff.append((num, name, idx, reg, val) + later[reg])
+                    t.coalesced += 1
+                    continue
+                else:
+                    later[reg] = (name, val)
+                kept.append((reg, val, text))
+            if len(kept) != len(t.entries):
+                t.entries = kept[::-1]
+                t.modified = True
+
+    # the PHY has to reach the same state at every barrier and boundary
+    entries = {name: t.entries for name, t in tables.items()}
+    for seg in segments:
+        if phy_states(tables, seg, orig) != phy_states(tables, seg, entries):
+            sys.exit('error: coalescing changes the PHY state of %s' % ', '.join(seg))
+    return diff
+
+
+def check_segments():
+    """
+    Coalesce a 3 FSP model: the PState reload snapshots fsp_phy_pie_cfg[i],
+    a write there is kept even though fsp_phy_cfg[i + 1] overwrites it.
+    """
+    fields = {'ddrphy_cfg': ['c'], 'fsp_phy_cfg': ['f0', 'f1', 'f2'],
+              'fsp_phy_pie_cfg': ['p0', 'p1', 'p2'], 'ddrphy_pie': ['pie']}
+    tables = {}
+    for field, names in fields.items():
+        for name in names:
+            entries = [(0x100, 1, ''), (0x100, 2, '')] if name == 'p1' else [(0x100, 0, '')]
+            tables[name] = Table(None, 'ddrphy_cfg_param', name, entries, None)
+    diff = coalesce(tables, phy_segments(fields))
+    if [d[1:3] for d in diff] != [('c', 0), ('p1', 0), ('p2', 0)]:
+        sys.exit('error: PHY segments do not match the PState reload model')
+
+
+def drop_tables(tables, fields, unused):
+    """Mark the tables only referenced through unused fields."""
+    used = set()
+    for field, names in fields.items():
+        if field not in unused:
+            used.update(names)
+    for t in tables.values():
+        t.dropped = t.name not in used
+
+
+def drop_fields(src, tables, fields, unused):
+    """Remove the descriptor initializers of unused fields and dropped tables."""
+    for field, names in fields.items():
+        for name in names:
+            if field in unused or tables[name].dropped:
+                src = re.sub(FIELD_LINE_RE % (field, name), '', src, flags=re.M)
+    return src
+
+
+def report(out, flow, tables, segments, diff, notes):
+    total_raw = total = elided = coalesced = 0
+    out.write('DDR timing tables, %s flow\n\n' % flow)
+    out.write('%-28s %8s %8s %9s %10s %10s\n' % ('table', 'writes', 'elided', 'coalesced',
+                                                 'raw bytes', 'bytes'))
+    for t in tables.values():
+        if not t.writes:
+            continue
+        out.write('%-28s %8d %8s %9d %10d %10s\n' % (t.name, t.writes,
+                                                     '-' if t.elided is None else t.elided,
+                                                     t.coalesced, t.raw_size(),
+                                                     'dropped' if t.dropped else t.size()))
+        total_raw += t.raw_size()
+        total += t.size()
+        elided += t.elided or 0
+        coalesced += t.coalesced
+    out.write('%-28s %8s %8d %9d %10d %10d\n' % ('total', '', elided, coalesced, total_raw, total))
+    if notes:
+        out.write('\n%s\n' % '\n'.join(notes))
+
+    if diff is not None:
+        out.write('\nCoalesced writes, per segment between firmware runs and PState reloads\n')
+        for num, seg in enumerate(segments):
+            writes = sorted(d[1:] for d in diff if d[0] == num)
+            out.write('\nsegment %d: %s, %d removed\n' % (num, ', '.join(seg), len(writes)))
+            for name, idx, reg, val, later, later_val in writes:
+                out.write('-%s[%d] {0x%x, 0x%x}, overwritten by %s with 0x%x\n' %
+                          (name, idx, reg, val, later, later_val))
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Convert DDR board timing tables')
+    parser.add_argument('input', help='board timing source file')
+    parser.add_argument('-o', '--output', required=True, help='generated timing source file')
+    parser.add_argument('--flow', choices=sorted(FLOW_UNUSED_FIELDS), default='train',
+                        help='DDR flow the image is built for')
+    parser.add_argument('--burst', action='store_true',
+                        help='run-encode the tables consumed by ddrphy_cfg_set()')
+    parser.add_argument('--coalesce', action='store_true',
+                        help='remove PHY writes overwritten before the next firmware run')
+    parser.add_argument('--reset-db', help='elide writes of the reset values listed in this file')
+    parser.add_argument('--report', help='write a table size report to this file')
+    args = parser.parse_args()
+
+    with open(args.input) as f:
+        src = f.read()
+
+    tables, fields = parse(src)
+
+    phy_tables = set()
+    for field in PHY_CFG_FIELDS:
+        phy_tables.update(fields.get(field, ()))
+
+    unused = FLOW_UNUSED_FIELDS[args.flow]
+    drop_tables(tables, fields, unused)
+
+    diff = None
+    notes = []
+    segments = phy_segments(fields)
+    if args.coalesce:
+        check_segments()
+        diff = coalesce(tables, segments)
+
+    if args.reset_db:
+        db = load_reset_db(args.reset_db)
+        # ddrc_config() applies the common table, then one FSP table
+        m = TIMING_RE.search(src)
+        common = [n for f, n in FIELD_RE.findall(m.group(1)) if f == 'ddrc_cfg'] if m else []
+        elide_resets(tables, common, db['ddrc'])
+        for name in fields.get('ddrc_cfg', []):
+            if name not in common:
+                elide_resets(tables, common + [name], db['ddrc'])
+        # ddr_cfg_phy() applies ddrphy_cfg and the first FSP PHY config
+        # before the first training firmware run
+        phy = fields.get('ddrphy_cfg', []) + fields.get('fsp_phy_cfg', [])[:1]
+        if db['ddrphy']:
+            elide_resets(tables, phy, db['ddrphy'])
+        else:
+            for name in phy_tables:
+                tables[name].elided = None
+            notes.append('PHY reset value elision unsupported: %s lists no ddrphy '
+                         'register' % args.reset_db)
+
+    # re-emit, replacing or dropping tables from the end backwards
+    out = src
+    for t in sorted(tables.values(), key=lambda t: t.span[0], reverse=True):
+        start, end = t.span
+        if t.dropped:
+            out = out[:start] + out[end:]
+            continue
+        if args.burst and t.name in phy_tables:
+            t.runs = encode_runs(t.entries)
+            if decode_runs(t.runs) != [e[:2] for e in t.entries]:
+                sys.exit('error: %s: run encoding does not round-trip' % t.name)
+            out = out[:start] + emit_runs(t) + out[end:]
+        elif t.modified:
+            out = out[:start] + emit_entries(t) + out[end:]
+    out = drop_fields(out, tables, fields, unused)
+
+    # the QuickBoot state keeps the PState SRAM of every FSP from 3 FSPs on
+    fsps = len(DRATE_RE.findall(src))
+    if fsps >= 3:
+        out += ('\n#if DDRPHY_QB_PSTATES < %d\n'
+                '#error "%d FSPs: build with -DDDRPHY_PSTATES=%d"\n#endif\n' % (fsps, fsps, fsps))
+
+    with open(args.output, 'w') as f:
+        f.write('/* Generated by scripts/ddr_timing.py from %s, do not edit */\n\n' % args.input)
+        f.write(out)
+
+    if args.report:
+        with open(args.report, 'w') as f:
+            report(f, args.flow, tables, segments, diff, notes)
+
+
+if __name__ == '__main__':
+    main()
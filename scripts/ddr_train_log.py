@@ -0,0 +1,143 @@
+#!/usr/bin/env python3
+# SPDX-License-Identifier: GPL-2.0+
+#
+# Copyright 2024 NXP
+#
+# Host decoder for the DDR training timeline recorded by TRAIN_LOG=yes
+# builds (source/ddr/ddr_train_log.c). The record is a memory dump of
+# struct ddr_train_log at DDR_TRAIN_LOG_MEM:
+#
+#   u32 magic ("DTLG"), num, lost, rsvd
+#   num entries of u32 ts (us), type, val
+#
+# Streaming messages are a string index, [31:16] string id and [15:0]
+# argument count, followed by their arguments. They are printed with
+# the format strings of the PHY firmware release when --strings is given,
+# a text file of "<hex string index> <format>" lines.
+
+import argparse
+import re
+import struct
+import sys
+
+DDR_TRAIN_LOG_MAGIC = 0x474c5444
+RUN, MAJOR, STRING, ARG, STEPS = range(5)
+
+STEP_NAMES = {
+    0x00: 'init',
+    0x01: 'fine write leveling',
+    0x02: 'read enable',
+    0x03: 'read delay center',
+    0x04: 'write delay center',
+    0x05: '2D read delay/voltage center',
+    0x06: '2D write delay/voltage center',
+    0x07: 'complete',
+    0x08: 'streaming message',
+    0x09: 'max read latency',
+    0x0a: 'read dq deskew',
+    0x0c: 'DB training',
+    0x0d: 'CA training',
+    0xfd: 'MPR read delay center',
+    0xfe: 'coarse write leveling',
+    0xff: 'FAILED',
+}
+
+FMT_RE = re.compile(r'%[-+ #0]*\d*(?:\.\d+)?[hl]*([diuxXc])')
+
+
+def load_log(name):
+    with open(name, 'rb') as f:
+        data = f.read()
+    magic, num, lost, _ = struct.unpack_from('<4I', data)
+    if magic != DDR_TRAIN_LOG_MAGIC:
+        sys.exit('error: %s: no training log (magic 0x%08x)' % (name, magic))
+    if 16 + 12 * num > len(data):
+        sys.exit('error: %s: truncated, %d entries expected' % (name, num))
+    return [struct.unpack_from('<3I', data, 16 + 12 * i) for i in range(num)], lost
+
+
+def load_strings(name):
+    strings = {}
+    with open(name) as f:
+        for line in f:
+            line = line.strip()
+            if not line or line.startswith('#'):
+                continue
+            idx, _, fmt = line.partition(' ')
+            strings[int(idx, 16)] = fmt.strip().strip('"')
+    return strings
+
+
+def format_message(index, args, strings):
+    fmt = strings.get(index)
+    if fmt is None:
+        return '0x%08x %s' % (index, ' '.join('0x%x' % a for a in args))
+
+    vals = iter(args)
+
+    def conv(m):
+        val = next(vals, 0)
+        if m.group(1) in 'di' and val & 0x80000000:
+            val -= 1 << 32
+        return ('%' + m.group(0)[1:].replace('l', '').replace('h', '')) % val
+    return FMT_RE.sub(conv, fmt.replace('\\n', ''))
+
+
+def messages(entries):
+    """Group the entries, yields (ts, type, val, args)."""
+    i = 0
+    while i < len(entries):
+        ts, typ, val = entries[i]
+        i += 1
+        args = []
+        if typ == STRING:
+            while i < len(entries) and entries[i][1] == ARG:
+                args.append(entries[i][2])
+                i += 1
+        yield ts, typ, val, args
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Decode the DDR training timeline')
+    parser.add_argument('log', help='dump of the training log record')
+    parser.add_argument('--strings', help='PHY firmware streaming message strings')
+    parser.add_argument('--summary', action='store_true',
+                        help='print the per-step durations only')
+    args = parser.parse_args()
+
+    entries, lost = load_log(args.log)
+    strings = load_strings(args.strings) if args.strings else {}
+
+    steps = {}
+    start = base = entries[0][0] if entries else 0
+    msgs = 0
+    for ts, typ, val, margs in messages(entries):
+        if typ == RUN:
+            start = ts
+            msgs = 0
+            print('%10d us  firmware run at %d MT/s' % (ts - base, val))
+        elif typ == STEPS:
+            print('%10s     SequenceCtrl 0x%04x' % ('', val))
+        elif typ == MAJOR and val != 0x08:
+            name = STEP_NAMES.get(val, 'unknown 0x%02x' % val)
+            dur = (ts - start) & 0xffffffff
+            total, count = steps.get(name, (0, 0))
+            steps[name] = (total + dur, count + 1)
+            if not args.summary:
+                print('%10d us  %s: %d us, %d messages' % (ts - base, name, dur, msgs))
+            start = ts
+            msgs = 0
+        elif typ == STRING:
+            msgs += 1
+            if not args.summary:
+                print('%10d us    %s' % (ts - base, format_message(val, margs, strings)))
+
+    print('\nstep durations:')
+    for name, (total, count) in sorted(steps.items(), key=lambda s: -s[1][0]):
+        print('  %-32s %8d us  (%d run%s)' % (name, total, count, 's' if count > 1 else ''))
+    if lost:
+        print('%d entries lost, the record holds %d' % (lost, len(entries)))
+
+
+if __name__ == '__main__':
+    main()
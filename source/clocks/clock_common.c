@@ -20,76 +20,172 @@
 
 static struct anatop_reg *ana_regs = (struct anatop_reg *)ANATOP_BASE_ADDR;
 
-struct imx_fracpll_rate_table imx9_fracpll_tbl[] = {
-	FRAC_PLL_RATE(1066666666U, 1, 133, 3, 1, 3), /* 1066.(6)Mhz */
-	FRAC_PLL_RATE(1000000000U, 1, 166, 4, 2, 3), /* 1000Mhz */
-	FRAC_PLL_RATE(933333333U, 1, 155, 4, 5, 9), /* 933.(3)Mhz */
-	FRAC_PLL_RATE(933000000U, 1, 155, 4, 1, 2), /* 933.(0)Mhz */
-	FRAC_PLL_RATE(800000000U, 1, 200, 6, 0, 1), /* 800Mhz */
-	FRAC_PLL_RATE(700000000U, 1, 145, 5, 5, 6), /* 700Mhz */
-	FRAC_PLL_RATE(600000000U, 1, 200, 8, 0, 1), /* 600Mhz */
-	FRAC_PLL_RATE(533333333U, 1, 133, 6, 1, 3), /* 533.(3)Mhz */
-	FRAC_PLL_RATE(484000000U, 1, 121, 6, 0, 1),
-	FRAC_PLL_RATE(466666666U, 1, 155, 8, 5, 9), /* 466.(6)Mhz */
-	FRAC_PLL_RATE(466000000U, 1, 155, 8, 1, 3), /* 466.(0)Mhz */
-	FRAC_PLL_RATE(400000000U, 1, 200, 12, 0, 1), /* 400Mhz */
-	FRAC_PLL_RATE(300000000U, 1, 150, 12, 0, 1),
-	FRAC_PLL_RATE(266666666U, 1, 177, 16, 7, 9), /* 266.(6)Mhz */
-	FRAC_PLL_RATE(233333333U, 1, 155, 16, 5, 9), /* 233.(3)Mhz */
-	FRAC_PLL_RATE(233000000U, 1, 174, 18, 3, 4), /* 233.(0)Mhz */
-	FRAC_PLL_RATE(200000000U, 1, 200, 24, 0, 1), /* 200Mhz */
-	FRAC_PLL_RATE(100000000U, 1, 200, 48, 0, 1), /* 100Mhz */
-	FRAC_PLL_RATE(0U, 0, 0, 0, 0, 0)
-};
+/* fracPLL reference clock, VCO range and max output divider */
+#define FRACPLL_FREF		24000000U
+#define FRACPLL_VCO_MIN_KHZ	2500000U
+#define FRACPLL_VCO_MAX_KHZ	5000000U
+#define FRACPLL_ODIV_MAX	255U
 
 /**
- * Fractional mode.
- * Set the output clock frequency for a fractional PLL.
- * The equations are:
- *      Fvco_clk = Fref / DIV[RDIV] * (DIV[MFI] + DENOMINATOR[MFN] / NUMERATOR[MFD])
- *      Fclko_odiv = Fvco_clk / DIV[ODIV]
- * RDIV, MFI, MFN, MFD, ODIV are provided in imx9_fracpll_tbl.
+ * Power-up time, rate and lock time, in us after the power-up, last
+ * observed for each fracPLL. live is set while the PLL runs locked at freq.
  */
-int configure_fracpll(enum ccm_clk_src pll, u32 freq)
-{
-	struct imx_fracpll_rate_table *rate;
-	struct ana_pll_reg *reg;
-	u32 i, pll_status;
+struct fracpll_lock_rec {
+	enum ccm_clk_src pll;
+	bool live;
+	u32 freq;
+	u32 start_us;
+	u32 lock_us;
+};
 
-	for (i = 0; i < ARRAY_SIZE(imx9_fracpll_tbl); i++) {
-		if (freq == imx9_fracpll_tbl[i].rate)
-			break;
-	}
+static struct fracpll_lock_rec fracpll_locks[] = {
+	{ .pll = SYS_PLL_PG },
+	{ .pll = DRAM_PLL_CLK },
+	{ .pll = VIDEO_PLL_CLK },
+#ifdef CONFIG_IMX95
+	{ .pll = AUDIO_PLL_CLK },
+	{ .pll = AUDIO_PLL2_CLK },
+#endif
+};
 
-	if (i == ARRAY_SIZE(imx9_fracpll_tbl)) {
-/*		debug("No matched freq table %u\n", freq); */
-		return -EINVAL;
+static struct fracpll_lock_rec *fracpll_lock_rec(enum ccm_clk_src pll)
+{
+	u32 i;
+
+	for (i = 0; i < ARRAY_SIZE(fracpll_locks); i++) {
+		if (fracpll_locks[i].pll == pll)
+			return &fracpll_locks[i];
 	}
 
-	rate = &imx9_fracpll_tbl[i];
+	return NULL;
+}
 
+static struct ana_pll_reg *fracpll_reg(enum ccm_clk_src pll)
+{
 	switch (pll) {
 	case SYS_PLL_PG:
-		reg = &ana_regs->sys_pll;
-		break;
+		return &ana_regs->sys_pll;
 	case DRAM_PLL_CLK:
-		reg = &ana_regs->dram_pll;
-		break;
+		return &ana_regs->dram_pll;
 	case VIDEO_PLL_CLK:
-		reg = &ana_regs->video_pll;
-		break;
+		return &ana_regs->video_pll;
 #ifdef CONFIG_IMX95
 	case AUDIO_PLL_CLK:
-		reg = &ana_regs->audio_pll;
-		break;
+		return &ana_regs->audio_pll;
 	case AUDIO_PLL2_CLK:
-		reg = &ana_regs->audio_pll2;
-		break;
+		return &ana_regs->audio_pll2;
 #endif
 	default:
+		return NULL;
+	}
+}
+
+static u32 fracpll_gcd(u32 a, u32 b)
+{
+	u32 t;
+
+	while (b) {
+		t = a % b;
+		a = b;
+		b = t;
+	}
+
+	return a;
+}
+
+/**
+ * Dividers for freq with RDIV 1: freq * ODIV is MFI reference clock periods
+ * and a remainder, MFN / MFD is that remainder over FRACPLL_FREF reduced,
+ * so that the output is freq exactly. The smallest ODIV that keeps the VCO
+ * in range with no fraction is preferred, the smallest one in range else.
+ * Only 32-bit integer operations, the VCO is compared in kHz.
+ */
+static int fracpll_solve(u32 freq, struct imx_fracpll_rate_table *rate)
+{
+	u32 odiv, mfi, rem, vco_khz, whole, part, g;
+
+	whole = freq / FRACPLL_FREF;
+	part = freq % FRACPLL_FREF;
+
+	rate->odiv = 0;
+	for (odiv = 1, mfi = whole, rem = part; odiv <= FRACPLL_ODIV_MAX; odiv++) {
+		if (odiv > 1) {
+			mfi += whole;
+			rem += part;
+			if (rem >= FRACPLL_FREF) {
+				rem -= FRACPLL_FREF;
+				mfi++;
+			}
+		}
+
+		/* ODIV 0 and 1 are encoded dividers, divide by 2 at least */
+		if (odiv < 2)
+			continue;
+
+		vco_khz = mfi * (FRACPLL_FREF / 1000U) + rem / 1000U;
+		if (vco_khz > FRACPLL_VCO_MAX_KHZ)
+			break;
+		if (vco_khz < FRACPLL_VCO_MIN_KHZ)
+			continue;
+
+		if (!rate->odiv || !rem) {
+			rate->odiv = odiv;
+			rate->mfi = mfi;
+			rate->mfn = rem;
+		}
+		if (!rem)
+			break;
+	}
+
+	if (!rate->odiv)
+		return -EINVAL;
+
+	g = fracpll_gcd(rate->mfn, FRACPLL_FREF);
+	rate->mfn /= g;
+	rate->mfd = FRACPLL_FREF / g;
+	rate->rdiv = 1;
+	rate->rate = freq;
+
+	return 0;
+}
+
+/**
+ * Fractional mode.
+ * Set the output clock frequency for a fractional PLL.
+ * The equations are:
+ *      Fvco_clk = Fref / DIV[RDIV] * (DIV[MFI] + DENOMINATOR[MFN] / NUMERATOR[MFD])
+ *      Fclko_odiv = Fvco_clk / DIV[ODIV]
+ * RDIV, MFI, MFN, MFD, ODIV are computed by fracpll_solve().
+ *
+ * fracpll_start() leaves the PLL bypassed and powering up, the caller may
+ * do other work until fracpll_locked() before calling fracpll_lock(). A PLL
+ * already running locked at freq is left as is.
+ */
+int fracpll_start(enum ccm_clk_src pll, u32 freq)
+{
+	struct imx_fracpll_rate_table div, *rate = &div;
+	struct fracpll_lock_rec *rec;
+	struct ana_pll_reg *reg;
+	int ret;
+
+	reg = fracpll_reg(pll);
+	rec = fracpll_lock_rec(pll);
+	if (!reg || !rec)
 		return -EPERM;
+
+	if (rec->live && rec->freq == freq) {
+		rec->lock_us = 0;
+		return 0;
+	}
+
+	ret = fracpll_solve(freq, rate);
+	if (ret) {
+/*		debug("No dividers for freq %u\n", freq); */
+		return ret;
 	}
 
+	rec->live = false;
+
 	/* Bypass the PLL to ref */
 	writel(PLL_CTRL_CLKMUX_BYPASS, &reg->ctrl.reg_set);
 
@@ -112,22 +208,68 @@ int configure_fracpll(enum ccm_clk_src pll, u32 freq)
 	udelay(5);
 #endif
 
-	/* power up the PLL and wait lock (max wait time 100 us) */
+	/* power up the PLL, lock takes up to FRACPLL_LOCK_US */
 	writel(PLL_CTRL_POWERUP, &reg->ctrl.reg_set);
+	rec->freq = freq;
+	rec->start_us = timer_get_us();
+	rec->lock_us = FRACPLL_LOCK_US;
 
-#ifndef CONFIG_IMX95_EMU
-	udelay(100);
-#endif
+	return 0;
+}
+
+bool fracpll_locked(enum ccm_clk_src pll)
+{
+	struct ana_pll_reg *reg = fracpll_reg(pll);
+
+	return reg && (readl(&reg->pll_status) & PLL_STATUS_PLL_LOCK);
+}
+
+/* Time the last lock of pll took after its power-up, freq is its rate */
+u32 fracpll_lock_time(enum ccm_clk_src pll, u32 *freq)
+{
+	struct fracpll_lock_rec *rec = fracpll_lock_rec(pll);
+
+	if (!rec)
+		return 0;
+
+	*freq = rec->freq;
+	return rec->lock_us;
+}
+
+/**
+ * Wait for the lock of a PLL started by fracpll_start(), up to
+ * FRACPLL_LOCK_US after its power-up, and enable its output
+ */
+int fracpll_lock(enum ccm_clk_src pll)
+{
+	struct fracpll_lock_rec *rec;
+	struct ana_pll_reg *reg;
+	u32 pll_status, now;
+
+	reg = fracpll_reg(pll);
+	rec = fracpll_lock_rec(pll);
+	if (!reg || !rec)
+		return -EPERM;
+
+	if (rec->live)
+		return 0;
+
+	do {
+		now = timer_get_us();
+		pll_status = readl(&reg->pll_status);
+	} while (!(pll_status & PLL_STATUS_PLL_LOCK) &&
+		 now - rec->start_us < FRACPLL_LOCK_US);
+
+	rec->lock_us = now - rec->start_us;
 
-	pll_status = readl(&reg->pll_status);
 	if (pll_status & PLL_STATUS_PLL_LOCK) {
 		writel(PLL_CTRL_CLKMUX_EN, &reg->ctrl.reg_set);
 
 		/* check the MFN is updated */
 		pll_status = readl(&reg->pll_status);
-		if ((pll_status & ~0x3) != (rate->mfn << 2)) {
+		if ((pll_status & ~0x3) != readl(&reg->num.reg)) {
 /*			debug("MFN update not matched, pll_status 0x%x, mfn 0x%x\n",
-			      pll_status, rate->mfn); */
+			      pll_status, readl(&reg->num.reg) >> 2); */
 #ifndef CONFIG_IMX95_EMU
 			return -EIO;
 #endif
@@ -135,6 +277,7 @@ int configure_fracpll(enum ccm_clk_src pll, u32 freq)
 
 		/* clear bypass */
 		writel(PLL_CTRL_CLKMUX_BYPASS, &reg->ctrl.reg_clr);
+		rec->live = true;
 
 	} else {
 /*		debug("Fail to lock PLL %u\n", pll); */
@@ -144,38 +287,73 @@ int configure_fracpll(enum ccm_clk_src pll, u32 freq)
 	return 0;
 }
 
-void dram_pll_init(ulong pll_val)
+int configure_fracpll(enum ccm_clk_src pll, u32 freq)
 {
-	configure_fracpll(DRAM_PLL_CLK, pll_val);
+	int ret;
+
+	ret = fracpll_start(pll, freq);
+	if (ret)
+		return ret;
+
+	return fracpll_lock(pll);
 }
 
-void dram_enable_bypass(ulong clk_val)
+int dram_pll_init(ulong pll_val)
 {
-	switch (clk_val) {
-	case MHZ(625):
-		ccm_clk_root_cfg(DRAM_ALT_CLK_ROOT, SYS_PLL_PFD2, 1);
-		break;
-	case MHZ(400):
-		ccm_clk_root_cfg(DRAM_ALT_CLK_ROOT, SYS_PLL_PFD1, 2);
-		break;
-	case MHZ(333):
-		ccm_clk_root_cfg(DRAM_ALT_CLK_ROOT, SYS_PLL_PFD0, 3);
-		break;
-	case MHZ(200):
-		ccm_clk_root_cfg(DRAM_ALT_CLK_ROOT, SYS_PLL_PFD1, 4);
-		break;
-	case MHZ(100):
-		ccm_clk_root_cfg(DRAM_ALT_CLK_ROOT, SYS_PLL_PFD1, 8);
-		break;
-	default:
-/*		printf("No matched freq table %lu\n", freq); */
-		return;
+	return configure_fracpll(DRAM_PLL_CLK, pll_val);
+}
+
+/* DRAM_ALT_CLK_ROOT sources in bypass, in MHz, first one kept on a tie */
+static const struct {
+	enum ccm_clk_src src;
+	u32 mhz;
+} dram_bypass_srcs[] = {
+	{ SYS_PLL_PFD1, 800 },
+	{ SYS_PLL_PFD0, 1000 },
+	{ SYS_PLL_PFD2, 625 },
+};
+
+/**
+ * Clock the DRAM from the CCM at clk_val, or at the closest rate below it
+ * a system PLL PFD divides to, rates compared in whole MHz
+ */
+int dram_enable_bypass(ulong clk_val)
+{
+	u32 i, mhz, div, best = 0, best_i = 0, best_div = 0;
+	int ret;
+
+	mhz = clk_val / MHZ(1);
+	if (!mhz)
+		return -EINVAL;
+
+	for (i = 0; i < ARRAY_SIZE(dram_bypass_srcs); i++) {
+		/* smallest divider not above mhz */
+		div = dram_bypass_srcs[i].mhz / (mhz + 1) + 1;
+		if (div > 256)
+			continue;
+		if (dram_bypass_srcs[i].mhz / div > best) {
+			best = dram_bypass_srcs[i].mhz / div;
+			best_i = i;
+			best_div = div;
+		}
 	}
 
+	if (!best)
+		return -EINVAL;
+
+	ret = ccm_clk_root_cfg(DRAM_ALT_CLK_ROOT, dram_bypass_srcs[best_i].src, best_div);
+	if (ret)
+		return ret;
+
 	/* Set DRAM APB to 133Mhz */
-	ccm_clk_root_cfg(DRAM_APB_CLK_ROOT, SYS_PLL_PFD1_DIV2, 3);
+	ret = ccm_clk_root_cfg(DRAM_APB_CLK_ROOT, SYS_PLL_PFD1_DIV2, 3);
+	if (ret)
+		return ret;
+
 	/* Switch from DRAM  clock root from PLL to CCM */
 	ccm_shared_gpr_set(SHARED_GPR_DRAM_CLK, SHARED_GPR_DRAM_CLK_SEL_CCM);
+
+	return 0;
 }
 
 void dram_disable_bypass(void)
@@ -17,6 +17,11 @@ struct imx95_ccm_clk_root_cfg {
 
 static struct imx95_ccm_clk_root_cfg clk_root_cfgs[] = {
 	{ DRAM_APB_CLK_ROOT, SYS_PLL_PFD1_DIV2, 3 }, /* 400MHz / 3 = 133.(3) MHz */
+#ifdef CONFIG_DDRPHY_EDMA
+	/* eDMA2 loads the DDR PHY firmware */
+	{ BUS_WAKEUP_CLK_ROOT, SYS_PLL_PFD1_DIV2, 3 }, /* 400MHz / 3 = 133.(3) MHz */
+	{ WAKEUP_AXI_CLK_ROOT, SYS_PLL_PFD1, 4 }, /* 800MHz / 4 = 200 MHz */
+#endif
 #ifdef DEBUG
 #if (DEBUG_UART_INSTANCE == 1)
 	{ LPUART1_CLK_ROOT, OSC_24M_CLK, 1}, /* 24MHz */
@@ -38,3 +43,41 @@ int clock_init(void)
 
 	return 0;
 }
+
+#if defined(CONFIG_CPU_BOOST)
+/*
+ * CPU clock root raised for the OEI run, CM33 only: the A55 rated maximum
+ * needs ARM_A55_CLK_ROOT on the ARM PLL, which the OEI does not program
+ */
+#if !defined(CM33)
+#error "CPU_BOOST=yes is only supported by the CM33 build"
+#endif
+#define CPU_CLK_ROOT		M33_CLK_ROOT
+#define CPU_CLK_BOOST_SRC	SYS_PLL_PFD0
+#define CPU_CLK_BOOST_DIV	3 /* 1000MHz / 3 = 333.(3) MHz */
+
+/**
+ * Raise the CPU clock root, ctrl is set to the configuration the ROM left
+ * for clock_cpu_restore() unless an error is returned
+ */
+int clock_cpu_boost(u32 *ctrl)
+{
+	int ret;
+
+	ret = ccm_clk_root_save(CPU_CLK_ROOT, ctrl);
+	if (ret)
+		return ret;
+
+	ret = ccm_clk_root_cfg(CPU_CLK_ROOT, CPU_CLK_BOOST_SRC, CPU_CLK_BOOST_DIV);
+	if (ret)
+		/* best effort back to the ROM configuration */
+		ccm_clk_root_restore(CPU_CLK_ROOT, *ctrl);
+
+	return ret;
+}
+
+int clock_cpu_restore(u32 ctrl)
+{
+	return ccm_clk_root_restore(CPU_CLK_ROOT, ctrl);
+}
+#endif
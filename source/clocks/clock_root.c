@@ -21,6 +21,15 @@
 
 static struct ccm_reg *ccm_reg = (struct ccm_reg *)CCM_BASE;
 
+/* Mux type + 1 of a clock root, 0 for the ids with no clock root */
+#define CLK_ROOT_MUX(type)	((type) + 1)
+
+struct clk_root_state {
+	u8 mux;
+	bool live;
+	u32 ctrl;
+};
+
 static enum ccm_clk_src clk_root_mux[][4] = {
 	{ OSC_24M_CLK, SYS_PLL_PFD0_DIV2, SYS_PLL_PFD1_DIV2, FRO_CLK },		/* Low-speed clocks */
 	{ OSC_24M_CLK, SYS_PLL_PFD0, SYS_PLL_PFD1_DIV2, FRO_CLK },		/* Non-IO clocks */
@@ -34,158 +43,216 @@ static enum ccm_clk_src clk_root_mux[][4] = {
 	{ OSC_24M_CLK, AUDIO_PLL_CLK, VIDEO_PLL_CLK, SYS_PLL_PFD2 },		/* hsio_acscan_480m */
 }; /*  In i.MX95, the CCM inputs video_pll2_clk and video_pll3_clk are connected to the ANAMIX output video_pll1_clk. */
 
-static struct clk_root_map clk_root_array[] = {
-	{ ADC_CLK_ROOT,			0 },
-	{ TMU_CLK_ROOT,			0 },
-	{ BUS_AON_CLK_ROOT,		0 },
-	{ CAN1_CLK_ROOT,		0 },
-	{ I3C1_CLK_ROOT,		0 },
-	{ I3C1_SLOW_CLK_ROOT,		0 },
-	{ LPI2C1_CLK_ROOT,		0 },
-	{ LPI2C2_CLK_ROOT,		0 },
-	{ LPSPI1_CLK_ROOT,		0 },
-	{ LPSPI2_CLK_ROOT,		0 },
-	{ LPTMR1_CLK_ROOT,		0 },
-	{ LPUART1_CLK_ROOT,		0 },
-	{ LPUART2_CLK_ROOT,		0 },
-	{ M33_CLK_ROOT,			1 },
-	{ M33_SYSTICK_CLK_ROOT,		0 },
-	{ MQS1_CLK_ROOT,		3 },
-	{ PDM_CLK_ROOT,			3 },
-	{ SAI1_CLK_ROOT,		3 },
-	{ ELE_CLK_ROOT,		        1 },
-	{ TPM2_CLK_ROOT,		8 },
-	{ CAM_APB_CLK_ROOT,		0 },
-	{ CAM_AXI_CLK_ROOT,		2 },
-	{ CAM_CM0_CLK_ROOT,		2 },
-	{ CAM_ISI_CLK_ROOT,		2 },
-	{ MIPI_PHY_CFG_CLK_ROOT,	4 },
-	{ MIPI_PHY_PLL_BYPASS_CLK_ROOT, 4 },
-	{ MIPI_PHY_PLL_REF_CLK_ROOT,	4 },
-	{ MIPI_TEST_BYTE_CLK_ROOT,	4 },
-	{ ARM_A55_CLK_ROOT,		2 },
-	{ ARM_A55_MTR_BUS_CLK_ROOT,	0 },
-	{ ARM_A55_PERIPH_CLK_ROOT,	2 },
-	{ DRAM_ALT_CLK_ROOT,		2 },
-	{ DRAM_APB_CLK_ROOT,		0 },
-	{ DISP_APB_CLK_ROOT,		0 },
-	{ DISP_AXI_CLK_ROOT,		2 },
-	{ DISP_OCRAM_CLK_ROOT,		2 },
-	{ DISP1_PIX_CLK_ROOT,		4 },
-	{ GPU_APB_CLK_ROOT,		0 },
-	{ GPU_CLK_ROOT,			2 },
-	{ HSIO_ACSCAN_480M_CLK_ROOT,	9 },
-	{ HSIO_ACSCAN_80M_CLK_ROOT,	0 },
-	{ HSIO_CLK_ROOT,		2 },
-	{ HSIO_PCIE_AUX_CLK_ROOT,	0 },
-	{ HSIO_PCIE_TEST_160M_CLK_ROOT, 2 },
-	{ HSIO_PCIE_TEST_400M_CLK_ROOT, 2 },
-	{ HSIO_PCIE_TEST_500M_CLK_ROOT, 2 },
-	{ HSIO_USB_TEST_50M_CLK_ROOT,	0 },
-	{ HSIO_USB_TEST_60M_CLK_ROOT,	0 },
-	{ BUS_M7_CLK_ROOT,		0 },
-	{ M7_CLK_ROOT,			2 },
-	{ M7_SYSTICK_CLK_ROOT,		0 },
-	{ BUS_NETCMIX_CLK_ROOT,		0 },
-	{ ENET_CLK_ROOT,		2 },
-	{ ENET_PHY_TEST_200M_CLK_ROOT,	1 },
-	{ ENET_PHY_TEST_500M_CLK_ROOT,	2 },
-	{ ENET_PHY_TEST_667M_CLK_ROOT,	2 },
-	{ ENET_REF_CLK_ROOT,		1 },
-	{ ENET_TIMER1_CLK_ROOT,		0 },
-	{ MQS2_CLK_ROOT,		3 },
-	{ SAI2_CLK_ROOT,		3 },
-	{ NOC_APB_CLK_ROOT,		0 },
-	{ NOC_CLK_ROOT,			2 },
-	{ NPU_APB_CLK_ROOT,		0 },
-	{ NPU_CLK_ROOT,			2 },
-	{ CCM_CKO1_CLK_ROOT,		5 },
-	{ CCM_CKO2_CLK_ROOT,		6 },
-	{ CCM_CKO3_CLK_ROOT,		7 },
-	{ CCM_CKO4_CLK_ROOT,		6 },
-	{ VPU_APB_CLK_ROOT,		0 },
-	{ VPU_CLK_ROOT,			2 },
-	{ VPU_JPEG_CLK_ROOT,		2 },
-	{ AUDIO_XCVR_CLK_ROOT,		1 },
-	{ BUS_WAKEUP_CLK_ROOT,		0 },
-	{ CAN2_CLK_ROOT,		0 },
-	{ CAN3_CLK_ROOT,		0 },
-	{ CAN4_CLK_ROOT,		0 },
-	{ CAN5_CLK_ROOT,		0 },
-	{ FLEXIO1_CLK_ROOT,		0 },
-	{ FLEXIO2_CLK_ROOT,		0 },
-	{ FLEXSPI1_CLK_ROOT,		2 },
-	{ I3C2_SLOW_CLK_ROOT,		0 },
-	{ LPI2C3_CLK_ROOT,		0 },
-	{ LPI2C4_CLK_ROOT, 		0 },
-	{ LPI2C5_CLK_ROOT, 		0 },
-	{ LPI2C6_CLK_ROOT, 		0 },
-	{ LPI2C7_CLK_ROOT, 		0 },
-	{ LPI2C8_CLK_ROOT, 		0 },
-	{ LPSPI3_CLK_ROOT, 		0 },
-	{ LPSPI4_CLK_ROOT, 		0 },
-	{ LPSPI5_CLK_ROOT, 		0 },
-	{ LPSPI6_CLK_ROOT, 		0 },
-	{ LPSPI7_CLK_ROOT, 		0 },
-	{ LPSPI8_CLK_ROOT, 		0 },
-	{ LPTMR2_CLK_ROOT,		0 },
-	{ LPUART3_CLK_ROOT,		0 },
-	{ LPUART4_CLK_ROOT, 		0 },
-	{ LPUART5_CLK_ROOT, 		0 },
-	{ LPUART6_CLK_ROOT, 		0 },
-	{ LPUART7_CLK_ROOT, 		0 },
-	{ LPUART8_CLK_ROOT, 		0 },
-	{ SAI3_CLK_ROOT,		3 },
-	{ SAI4_CLK_ROOT, 		3 },
-	{ SAI5_CLK_ROOT, 		3 },
-	{ SPDIF_CLK_ROOT,		3 },
-	{ SWO_TRACE_CLK_ROOT,		0 },
-	{ TPM4_CLK_ROOT,		8 },
-	{ TPM5_CLK_ROOT, 		8 },
-	{ TPM6_CLK_ROOT, 		8 },
-	{ USB_PHY_BURUNIN_CLK_ROOT,	0 },
-	{ USDHC1_CLK_ROOT,		2 },
-	{ USDHC2_CLK_ROOT,		2 },
-	{ USDHC3_CLK_ROOT,		2 },
-	{ V2X_PK_CLK_ROOT,		2 },
-	{ WAKEUP_AXI_CLK_ROOT,		2 },
-	{ XSPI_SLV_ROOT_CLK_ROOT,	2 },
+/**
+ * Clock root mux type, indexed by clock root id, and the control register
+ * value last read or written while live is set
+ */
+static struct clk_root_state clk_roots[CLK_ROOT_NUM] = {
+	[ADC_CLK_ROOT]			= { CLK_ROOT_MUX(0) },
+	[TMU_CLK_ROOT]			= { CLK_ROOT_MUX(0) },
+	[BUS_AON_CLK_ROOT]		= { CLK_ROOT_MUX(0) },
+	[CAN1_CLK_ROOT]			= { CLK_ROOT_MUX(0) },
+	[I3C1_CLK_ROOT]			= { CLK_ROOT_MUX(0) },
+	[I3C1_SLOW_CLK_ROOT]		= { CLK_ROOT_MUX(0) },
+	[LPI2C1_CLK_ROOT]		= { CLK_ROOT_MUX(0) },
+	[LPI2C2_CLK_ROOT]		= { CLK_ROOT_MUX(0) },
+	[LPSPI1_CLK_ROOT]		= { CLK_ROOT_MUX(0) },
+	[LPSPI2_CLK_ROOT]		= { CLK_ROOT_MUX(0) },
+	[LPTMR1_CLK_ROOT]		= { CLK_ROOT_MUX(0) },
+	[LPUART1_CLK_ROOT]		= { CLK_ROOT_MUX(0) },
+	[LPUART2_CLK_ROOT]		= { CLK_ROOT_MUX(0) },
+	[M33_CLK_ROOT]			= { CLK_ROOT_MUX(1) },
+	[M33_SYSTICK_CLK_ROOT]		= { CLK_ROOT_MUX(0) },
+	[MQS1_CLK_ROOT]			= { CLK_ROOT_MUX(3) },
+	[PDM_CLK_ROOT]			= { CLK_ROOT_MUX(3) },
+	[SAI1_CLK_ROOT]			= { CLK_ROOT_MUX(3) },
+	[ELE_CLK_ROOT]			= { CLK_ROOT_MUX(1) },
+	[TPM2_CLK_ROOT]			= { CLK_ROOT_MUX(8) },
+	[CAM_APB_CLK_ROOT]		= { CLK_ROOT_MUX(0) },
+	[CAM_AXI_CLK_ROOT]		= { CLK_ROOT_MUX(2) },
+	[CAM_CM0_CLK_ROOT]		= { CLK_ROOT_MUX(2) },
+	[CAM_ISI_CLK_ROOT]		= { CLK_ROOT_MUX(2) },
+	[MIPI_PHY_CFG_CLK_ROOT]		= { CLK_ROOT_MUX(4) },
+	[MIPI_PHY_PLL_BYPASS_CLK_ROOT]	= { CLK_ROOT_MUX(4) },
+	[MIPI_PHY_PLL_REF_CLK_ROOT]	= { CLK_ROOT_MUX(4) },
+	[MIPI_TEST_BYTE_CLK_ROOT]	= { CLK_ROOT_MUX(4) },
+	[ARM_A55_CLK_ROOT]		= { CLK_ROOT_MUX(2) },
+	[ARM_A55_MTR_BUS_CLK_ROOT]	= { CLK_ROOT_MUX(0) },
+	[ARM_A55_PERIPH_CLK_ROOT]	= { CLK_ROOT_MUX(2) },
+	[DRAM_ALT_CLK_ROOT]		= { CLK_ROOT_MUX(2) },
+	[DRAM_APB_CLK_ROOT]		= { CLK_ROOT_MUX(0) },
+	[DISP_APB_CLK_ROOT]		= { CLK_ROOT_MUX(0) },
+	[DISP_AXI_CLK_ROOT]		= { CLK_ROOT_MUX(2) },
+	[DISP_OCRAM_CLK_ROOT]		= { CLK_ROOT_MUX(2) },
+	[DISP1_PIX_CLK_ROOT]		= { CLK_ROOT_MUX(4) },
+	[GPU_APB_CLK_ROOT]		= { CLK_ROOT_MUX(0) },
+	[GPU_CLK_ROOT]			= { CLK_ROOT_MUX(2) },
+	[HSIO_ACSCAN_480M_CLK_ROOT]	= { CLK_ROOT_MUX(9) },
+	[HSIO_ACSCAN_80M_CLK_ROOT]	= { CLK_ROOT_MUX(0) },
+	[HSIO_CLK_ROOT]			= { CLK_ROOT_MUX(2) },
+	[HSIO_PCIE_AUX_CLK_ROOT]	= { CLK_ROOT_MUX(0) },
+	[HSIO_PCIE_TEST_160M_CLK_ROOT]	= { CLK_ROOT_MUX(2) },
+	[HSIO_PCIE_TEST_400M_CLK_ROOT]	= { CLK_ROOT_MUX(2) },
+	[HSIO_PCIE_TEST_500M_CLK_ROOT]	= { CLK_ROOT_MUX(2) },
+	[HSIO_USB_TEST_50M_CLK_ROOT]	= { CLK_ROOT_MUX(0) },
+	[HSIO_USB_TEST_60M_CLK_ROOT]	= { CLK_ROOT_MUX(0) },
+	[BUS_M7_CLK_ROOT]		= { CLK_ROOT_MUX(0) },
+	[M7_CLK_ROOT]			= { CLK_ROOT_MUX(2) },
+	[M7_SYSTICK_CLK_ROOT]		= { CLK_ROOT_MUX(0) },
+	[BUS_NETCMIX_CLK_ROOT]		= { CLK_ROOT_MUX(0) },
+	[ENET_CLK_ROOT]			= { CLK_ROOT_MUX(2) },
+	[ENET_PHY_TEST_200M_CLK_ROOT]	= { CLK_ROOT_MUX(1) },
+	[ENET_PHY_TEST_500M_CLK_ROOT]	= { CLK_ROOT_MUX(2) },
+	[ENET_PHY_TEST_667M_CLK_ROOT]	= { CLK_ROOT_MUX(2) },
+	[ENET_REF_CLK_ROOT]		= { CLK_ROOT_MUX(1) },
+	[ENET_TIMER1_CLK_ROOT]		= { CLK_ROOT_MUX(0) },
+	[MQS2_CLK_ROOT]			= { CLK_ROOT_MUX(3) },
+	[SAI2_CLK_ROOT]			= { CLK_ROOT_MUX(3) },
+	[NOC_APB_CLK_ROOT]		= { CLK_ROOT_MUX(0) },
+	[NOC_CLK_ROOT]			= { CLK_ROOT_MUX(2) },
+	[NPU_APB_CLK_ROOT]		= { CLK_ROOT_MUX(0) },
+	[NPU_CLK_ROOT]			= { CLK_ROOT_MUX(2) },
+	[CCM_CKO1_CLK_ROOT]		= { CLK_ROOT_MUX(5) },
+	[CCM_CKO2_CLK_ROOT]		= { CLK_ROOT_MUX(6) },
+	[CCM_CKO3_CLK_ROOT]		= { CLK_ROOT_MUX(7) },
+	[CCM_CKO4_CLK_ROOT]		= { CLK_ROOT_MUX(6) },
+	[VPU_APB_CLK_ROOT]		= { CLK_ROOT_MUX(0) },
+	[VPU_CLK_ROOT]			= { CLK_ROOT_MUX(2) },
+	[VPU_JPEG_CLK_ROOT]		= { CLK_ROOT_MUX(2) },
+	[AUDIO_XCVR_CLK_ROOT]		= { CLK_ROOT_MUX(1) },
+	[BUS_WAKEUP_CLK_ROOT]		= { CLK_ROOT_MUX(0) },
+	[CAN2_CLK_ROOT]			= { CLK_ROOT_MUX(0) },
+	[CAN3_CLK_ROOT]			= { CLK_ROOT_MUX(0) },
+	[CAN4_CLK_ROOT]			= { CLK_ROOT_MUX(0) },
+	[CAN5_CLK_ROOT]			= { CLK_ROOT_MUX(0) },
+	[FLEXIO1_CLK_ROOT]		= { CLK_ROOT_MUX(0) },
+	[FLEXIO2_CLK_ROOT]		= { CLK_ROOT_MUX(0) },
+	[FLEXSPI1_CLK_ROOT]		= { CLK_ROOT_MUX(2) },
+	[I3C2_SLOW_CLK_ROOT]		= { CLK_ROOT_MUX(0) },
+	[LPI2C3_CLK_ROOT]		= { CLK_ROOT_MUX(0) },
+	[LPI2C4_CLK_ROOT]		= { CLK_ROOT_MUX(0) },
+	[LPI2C5_CLK_ROOT]		= { CLK_ROOT_MUX(0) },
+	[LPI2C6_CLK_ROOT]		= { CLK_ROOT_MUX(0) },
+	[LPI2C7_CLK_ROOT]		= { CLK_ROOT_MUX(0) },
+	[LPI2C8_CLK_ROOT]		= { CLK_ROOT_MUX(0) },
+	[LPSPI3_CLK_ROOT]		= { CLK_ROOT_MUX(0) },
+	[LPSPI4_CLK_ROOT]		= { CLK_ROOT_MUX(0) },
+	[LPSPI5_CLK_ROOT]		= { CLK_ROOT_MUX(0) },
+	[LPSPI6_CLK_ROOT]		= { CLK_ROOT_MUX(0) },
+	[LPSPI7_CLK_ROOT]		= { CLK_ROOT_MUX(0) },
+	[LPSPI8_CLK_ROOT]		= { CLK_ROOT_MUX(0) },
+	[LPTMR2_CLK_ROOT]		= { CLK_ROOT_MUX(0) },
+	[LPUART3_CLK_ROOT]		= { CLK_ROOT_MUX(0) },
+	[LPUART4_CLK_ROOT]		= { CLK_ROOT_MUX(0) },
+	[LPUART5_CLK_ROOT]		= { CLK_ROOT_MUX(0) },
+	[LPUART6_CLK_ROOT]		= { CLK_ROOT_MUX(0) },
+	[LPUART7_CLK_ROOT]		= { CLK_ROOT_MUX(0) },
+	[LPUART8_CLK_ROOT]		= { CLK_ROOT_MUX(0) },
+	[SAI3_CLK_ROOT]			= { CLK_ROOT_MUX(3) },
+	[SAI4_CLK_ROOT]			= { CLK_ROOT_MUX(3) },
+	[SAI5_CLK_ROOT]			= { CLK_ROOT_MUX(3) },
+	[SPDIF_CLK_ROOT]		= { CLK_ROOT_MUX(3) },
+	[SWO_TRACE_CLK_ROOT]		= { CLK_ROOT_MUX(0) },
+	[TPM4_CLK_ROOT]			= { CLK_ROOT_MUX(8) },
+	[TPM5_CLK_ROOT]			= { CLK_ROOT_MUX(8) },
+	[TPM6_CLK_ROOT]			= { CLK_ROOT_MUX(8) },
+	[USB_PHY_BURUNIN_CLK_ROOT]	= { CLK_ROOT_MUX(0) },
+	[USDHC1_CLK_ROOT]		= { CLK_ROOT_MUX(2) },
+	[USDHC2_CLK_ROOT]		= { CLK_ROOT_MUX(2) },
+	[USDHC3_CLK_ROOT]		= { CLK_ROOT_MUX(2) },
+	[V2X_PK_CLK_ROOT]		= { CLK_ROOT_MUX(2) },
+	[WAKEUP_AXI_CLK_ROOT]		= { CLK_ROOT_MUX(2) },
+	[XSPI_SLV_ROOT_CLK_ROOT]	= { CLK_ROOT_MUX(2) },
 };
 #endif
 
-int ccm_clk_root_cfg(u32 clk_root_id, enum ccm_clk_src src, u32 div)
+/* State of a clock root, its control register is read on the first use */
+static struct clk_root_state *ccm_clk_root_state(u32 clk_root_id)
 {
+	struct clk_root_state *root = &clk_roots[clk_root_id];
+
+	if (!root->live) {
+		root->ctrl = readl(&ccm_reg->clk_roots[clk_root_id].control);
+		root->live = true;
+	}
+
+	return root;
+}
+
+/**
+ * Write the control register of a clock root unless it already holds ctrl.
+ * The state follows the write once the root has switched, a root that
+ * timed out is read again on its next use.
+ */
+static int ccm_clk_root_write(u32 clk_root_id, u32 ctrl)
+{
+	struct clk_root_state *root = ccm_clk_root_state(clk_root_id);
+	u32 status;
 	int ret;
-	u32 i, mux, status;
 
-	if (clk_root_id >= CLK_ROOT_NUM || div > 256 || div == 0)
-		return -EINVAL;
+	if (root->ctrl == ctrl)
+		return 0;
 
-	for (i = 0; i < ARRAY_SIZE(clk_root_array); i++) {
-		if (clk_root_array[i].clk_root_id == clk_root_id )
-			break;
+	writel(ctrl, &ccm_reg->clk_roots[clk_root_id].control);
+	ret = readl_poll_timeout(&ccm_reg->clk_roots[clk_root_id].status0, status,
+				 !(status & CLK_ROOT_STATUS_CHANGING), 200000);
+	if (ret) {
+		root->live = false;
+		return ret;
 	}
 
-	if(i == ARRAY_SIZE(clk_root_array))
+	root->ctrl = ctrl;
+
+	return 0;
+}
+
+/**
+ * Switch a clock root to src / div, nothing is done when the root already
+ * runs from that configuration
+ */
+int ccm_clk_root_cfg(u32 clk_root_id, enum ccm_clk_src src, u32 div)
+{
+	struct clk_root_state *root;
+	u32 i;
+
+	if (clk_root_id >= CLK_ROOT_NUM || div > 256 || div == 0)
 		return -EINVAL;
 
-	mux = clk_root_array[i].mux_type;
+	root = &clk_roots[clk_root_id];
+	if (!root->mux)
+		return -EINVAL;
 
 	for (i = 0; i < 4; i++) {
-		if (src == clk_root_mux[mux][i])
+		if (src == clk_root_mux[root->mux - 1][i])
 			break;
 	}
 
 	if (i == 4)
 		return -EINVAL;
 
-	writel((i << 8) | (div - 1), &ccm_reg->clk_roots[clk_root_id].control);
-
-	ret = readl_poll_timeout(&ccm_reg->clk_roots[clk_root_id].status0, status,
-				 !(status & CLK_ROOT_STATUS_CHANGING), 200000);
-	return ret;
+	return ccm_clk_root_write(clk_root_id, (i << 8) | (div - 1));
 };
 
+/* Control register value of a clock root, for ccm_clk_root_restore() */
+int ccm_clk_root_save(u32 clk_root_id, u32 *ctrl)
+{
+	if (clk_root_id >= CLK_ROOT_NUM || !clk_roots[clk_root_id].mux)
+		return -EINVAL;
+
+	*ctrl = ccm_clk_root_state(clk_root_id)->ctrl;
+
+	return 0;
+}
+
+/* Switch a clock root back to the configuration saved by ccm_clk_root_save() */
+int ccm_clk_root_restore(u32 clk_root_id, u32 ctrl)
+{
+	if (clk_root_id >= CLK_ROOT_NUM || !clk_roots[clk_root_id].mux)
+		return -EINVAL;
+
+	return ccm_clk_root_write(clk_root_id, ctrl);
+}
+
 int ccm_shared_gpr_set(u32 gpr, u32 val)
 {
 	if (gpr >= SHARED_GPR_NUM)
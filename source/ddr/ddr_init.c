@@ -4,8 +4,9 @@
  */
 #include "ddr.h"
 #include <asm/io.h>
-#include "time.h"
-#include "iopoll.h"
+#include <errno.h>
+#include <time.h>
+#include "debug.h"
 
 #define MAX(a, b)	(((a) > (b)) ? (a) : (b))
 
@@ -24,28 +25,17 @@
 
 #define SRC_DDRMIX_PRM_BASE_ADDR	SRC_BASE + 0x3500U
 
-static void check_ddrc_idle(void)
-{
-	u32 regval;
-
-	do {
-		regval = readl(REG_DDRDSR_2);
-		if (regval & BIT(31))
-			break;
-	} while (1);
-}
-
-static void check_dfi_init_complete(void)
-{
-	u32 regval;
-
-	do {
-		regval = readl(REG_DDRDSR_2);
-		if (regval & BIT(2))
-			break;
-	} while (1);
-	setbits_le32(REG_DDRDSR_2, BIT(2));
-}
+/**
+ * Wait for DFI init complete and acknowledge it, start the controller
+ * and wait for it to be idle and for the MTCR command to finish
+ */
+static const u16 ddrc_start_seq[] = {
+	SEQ_POLL(REG_DDRDSR_2, BIT(2), BIT(2), 0),
+	SEQ_SETBITS(REG_DDRDSR_2, BIT(2)),
+	SEQ_SETBITS(REG_DDR_SDRAM_CFG, BIT(31)),
+	SEQ_POLL(REG_DDRDSR_2, BIT(31), BIT(31), 0),
+	SEQ_POLL(REG_DDR_MTCR, BIT(31), 0, 0),
+};
 
 int ddrc_config(struct dram_timing_info *dtiming, uint32 fsp_id)
 {
@@ -84,58 +74,120 @@ int ddrc_config(struct dram_timing_info *dtiming, uint32 fsp_id)
 	return 0;
 }
 
-static void ddrphy_coldreset(void)
-{
-	/**
-	 * BIT(8) => src_ipc_ddrphy_presetn, PRESETN
-	 * BIT(9) => src_ipc_ddrphy_reset_n, RESET_N
-	 *
-	 * DfiClk is 790MHz in waveform ~= 800MHz ?
-	 * APBCLK is 200MHz in waveform
-	 */
-	u32 stat;
-
+/**
+ * BIT(8) => src_ipc_ddrphy_presetn, PRESETN
+ * BIT(9) => src_ipc_ddrphy_reset_n, RESET_N
+ *
+ * DfiClk is 790MHz in waveform ~= 800MHz ?
+ * APBCLK is 200MHz in waveform
+ */
+static const u16 ddrphy_coldreset_seq[] = {
 	/**
 	 * for some reason BIT(8)=1 at this point, so PRESETN go LOW after power-up
 	 * Ensure PRESETN go HIGH after power-up
 	 * Ensure RESET_N go LOW  after power-up
 	 */
-	clrbits_le32(SRC_DDRMIX_PRS_IRST_REQ_CTRL, BIT(8));
-	setbits_le32(SRC_DDRMIX_PRS_IRST_REQ_CTRL, BIT(9));
+	SEQ_CLRBITS(SRC_DDRMIX_PRS_IRST_REQ_CTRL, BIT(8)),
+	SEQ_SETBITS(SRC_DDRMIX_PRS_IRST_REQ_CTRL, BIT(9)),
 
 	/* Disable IPs isolation in DDRMIX */
-	clrbits_le32(SRC_DDRMIX_PRS_SLICE_SW_CTRL, 0x7f000000);
+	SEQ_CLRBITS(SRC_DDRMIX_PRS_SLICE_SW_CTRL, 0x7f000000),
 	/* Power-up DDRMIX */
-	clrbits_le32(SRC_DDRMIX_PRS_SLICE_SW_CTRL, BIT(31));
+	SEQ_CLRBITS(SRC_DDRMIX_PRS_SLICE_SW_CTRL, BIT(31)),
 	/* Wait resets to be released => BIT(2) being set */
-	readl_poll_timeout(SRC_DDRMIX_PRS_FUNC_STAT, stat, (stat & BIT(2)), 0);
+	SEQ_POLL(SRC_DDRMIX_PRS_FUNC_STAT, BIT(2), BIT(2), 0),
 	/* sleep for a while, just random */
-	udelay(8);
+	SEQ_UDELAY(8),
 	/* set PRESETN LOW after power-up */
-	setbits_le32(SRC_DDRMIX_PRS_IRST_REQ_CTRL, BIT(8));
+	SEQ_SETBITS(SRC_DDRMIX_PRS_IRST_REQ_CTRL, BIT(8)),
 	/* The delay below must be at least 16 APBCLK
 	 * APBCLK is @200MHz in waveform. Timer clock is @24MHz =>
 	 * => (16 * 24.000.000 / 200.000.000) = 1.92us minimum
 	 * => set x4 = 8us */
-	udelay(8);
+	SEQ_UDELAY(8),
 	/* set PRESETN HIGH */
-	clrbits_le32(SRC_DDRMIX_PRS_IRST_REQ_CTRL, BIT(8));
+	SEQ_CLRBITS(SRC_DDRMIX_PRS_IRST_REQ_CTRL, BIT(8)),
 	/* The delay below shall be 0 according to PHY PUB, set 8 just in case */
-	udelay(8);
-	/* set RESET_N HIGH */
-	clrbits_le32(SRC_DDRMIX_PRS_IRST_REQ_CTRL, BIT(9));
-	/* The duration for the delay below is not mentioned in PHY PUB, set 8 just in case */
-	udelay(8);
+	SEQ_UDELAY(8),
+	/* set RESET_N HIGH, followed by DDRPHY_RESET_SETTLE_US */
+	SEQ_CLRBITS(SRC_DDRMIX_PRS_IRST_REQ_CTRL, BIT(9)),
+};
+
+/* The duration of this delay is not mentioned in PHY PUB, set 8 just in case */
+#define DDRPHY_RESET_SETTLE_US	8
+
+#if defined(DDR_TRAIN_FLOW)
+static int ddr_train(struct dram_timing_info *dtiming, struct ddr_bringup *bu)
+{
+	ddrphy_qb_mr mr[DDRPHY_QB_FSP_MAX];
+	int ret;
+
+	/*
+	 * Start PHY initialization and training by
+	 * accessing relevant PUB registers
+	 */
+	ret = ddr_cfg_phy(dtiming, bu, mr);
+	if (ret)
+		return ret;
+
+	ddrphy_qb_save(dtiming, mr);
+
+	return 0;
+}
+#endif
+
+#if defined(CONFIG_DDR_QBOOT_AUTO)
+/**
+ * QuickBoot when the saved QB state is valid, full training and a new
+ * QB state otherwise. A failed QuickBoot leaves the PHY half configured,
+ * it is reset again before training.
+ */
+static int ddr_cfg_phy_auto(struct dram_timing_info *dtiming, u32 fsp_id,
+			    struct ddr_bringup *bu)
+{
+	int ret;
+#ifdef DEBUG
+	u32 ts = timer_get_us();
+#endif
+
+	ret = ddr_cfg_phy_qb(dtiming, fsp_id, bu);
+	if (!ret) {
+#ifdef DEBUG
+		printf("** DDR OEI: QuickBoot done in %u us **\n", timer_get_us() - ts);
+#endif
+		return 0;
+	}
+
+#ifdef DEBUG
+	printf("** DDR OEI: QuickBoot failed (%d) after %u us, training **\n", ret,
+	       timer_get_us() - ts);
+#endif
+
+	ret = ddr_seq_exec(ddrphy_coldreset_seq);
+	if (ret)
+		return ret;
+	bu->settle_us = timer_get_us() + DDRPHY_RESET_SETTLE_US;
+
+#ifdef DEBUG
+	ts = timer_get_us();
+#endif
+	ret = ddr_train(dtiming, bu);
+	if (ret)
+		return ret;
+
+#ifdef DEBUG
+	printf("** DDR OEI: training done in %u us **\n", timer_get_us() - ts);
+#endif
+	return 0;
 }
+#endif
 
 int ddr_init(struct dram_timing_info *dtiming)
 {
+	struct ddr_bringup bu;
 	int ret;
 	u32 fsp_id, drate;
 
-	/* reset ddrphy */
-	ddrphy_coldreset();
-
 	/**
 	 * FSP ID must point to the last trained FSP
 	 * so that the proper DDRC config - for the
@@ -144,35 +196,33 @@ int ddr_init(struct dram_timing_info *dtiming)
 	 */
 	fsp_id = dtiming->fsp_msg_num - 1;
 	drate = dtiming->fsp_msg[fsp_id].drate;
-	/* default to the last frequency point clock */
-	ddrphy_init_set_dfi_clk(drate);
-
-#if defined(CONFIG_DDR_QBOOT)
-	/* Configure PHY in QuickBoot mode */
-	ret = ddr_cfg_phy_qb(dtiming, fsp_id);
+	/* reset ddrphy */
+	ret = ddr_seq_exec(ddrphy_coldreset_seq);
 	if (ret)
 		return ret;
-#else
-	/*
-	 * Start PHY initialization and training by
-	 * accessing relevant PUB registers
+	bu.settle_us = timer_get_us() + DDRPHY_RESET_SETTLE_US;
+
+	/**
+	 * default to the last frequency point clock, the DRAM PLL
+	 * locks during the reset settle window and the firmware load
 	 */
-	ret = ddr_cfg_phy(dtiming);
+	ret = ddrphy_dfi_clk_start(&bu, drate);
 	if (ret)
 		return ret;
 
-	ddrphy_qb_save();
+#if defined(CONFIG_DDR_QBOOT_AUTO)
+	ret = ddr_cfg_phy_auto(dtiming, fsp_id, &bu);
+#elif defined(CONFIG_DDR_QBOOT)
+	/* Configure PHY in QuickBoot mode */
+	ret = ddr_cfg_phy_qb(dtiming, fsp_id, &bu);
+#else
+	ret = ddr_train(dtiming, &bu);
 #endif
+	if (ret)
+		return ret;
+
 	/* program the ddrc registers */
 	ddrc_config(dtiming, fsp_id);
 
-	check_dfi_init_complete();
-
-	setbits_le32(REG_DDR_SDRAM_CFG, BIT(31)); /* |= 0x80000000 */
-
-	check_ddrc_idle();
-
-	while (readl(REG_DDR_MTCR) & 0x80000000);
-
-	return 0;
+	return ddr_seq_exec(ddrc_start_seq);
 }
@@ -0,0 +1,78 @@
+// SPDX-License-Identifier: GPL-2.0+
+/*
+ * Copyright 2024 NXP
+ */
+#include "ddr.h"
+#include <asm/io.h>
+#include "time.h"
+#include "iopoll.h"
+
+static inline u32 seq_u32(const unsigned short *p)
+{
+	return p[0] | ((u32)p[1] << 16);
+}
+
+/**
+ * Execute a DDR register sequence (see DDR_SEQ_* in ddr.h), len is the
+ * sequence length in halfwords.
+ *
+ * Returns 0 on success, -ETIMEDOUT if a POLL timed out, -EINVAL on a
+ * malformed sequence.
+ */
+int ddr_seq_run(const unsigned short *seq, unsigned int len)
+{
+	const unsigned short *end = seq + len;
+	volatile unsigned int *reg;
+	unsigned int hdr, cnt, addr, mask, val, tmo_us;
+	int ret;
+
+	while (seq < end) {
+		hdr = *seq++;
+
+		switch (hdr >> 12) {
+		case DDR_SEQ_BURST:
+		case DDR_SEQ_FILL:
+			cnt  = hdr & 0xff;
+			addr = ((hdr & 0xf00) << 8) | *seq++;
+			reg  = (volatile unsigned int *)(IP2APB_DDRPHY_IPS_BASE_ADDR(0) +
+							 ddrphy_addr_remap(addr));
+
+			if ((hdr >> 12) == DDR_SEQ_FILL) {
+				val = *seq++;
+				while (cnt--)
+					*reg++ = val;
+			} else {
+				while (cnt--)
+					*reg++ = *seq++;
+			}
+			break;
+		case DDR_SEQ_WRITE:
+			addr = seq_u32(seq);
+			writel(seq_u32(seq + 2), addr);
+			seq += 4;
+			break;
+		case DDR_SEQ_RMW:
+			addr = seq_u32(seq);
+			writel((readl(addr) & ~seq_u32(seq + 2)) | seq_u32(seq + 4), addr);
+			seq += 6;
+			break;
+		case DDR_SEQ_POLL:
+			addr   = seq_u32(seq);
+			mask   = seq_u32(seq + 2);
+			tmo_us = hdr & DDR_SEQ_ARG_MAX;
+			ret = readl_poll_timeout(addr, val, (val & mask) == seq_u32(seq + 4),
+						 tmo_us);
+			if (ret)
+				return ret;
+			seq += 6;
+			break;
+		case DDR_SEQ_DELAY:
+			udelay(hdr & DDR_SEQ_ARG_MAX);
+			break;
+		default:
+			return -EINVAL;
+		}
+	}
+
+	return 0;
+}
@@ -0,0 +1,112 @@
+// SPDX-License-Identifier: GPL-2.0+
+/*
+ * Copyright 2024 NXP
+ */
+#include "ddr.h"
+#include "debug.h"
+#include "time.h"
+
+static struct ddr_train_log *train_log = (struct ddr_train_log *)DDR_TRAIN_LOG_MEM;
+
+void ddr_train_log_init(void)
+{
+	train_log->magic = DDR_TRAIN_LOG_MAGIC;
+	train_log->num = 0;
+	train_log->lost = 0;
+	train_log->rsvd = 0;
+}
+
+void ddr_train_log(u32 type, u32 val)
+{
+	struct ddr_train_log_ent *ent;
+
+	if (train_log->num == DDR_TRAIN_LOG_NUM) {
+		train_log->lost++;
+		return;
+	}
+
+	ent = &train_log->ent[train_log->num++];
+	ent->ts = timer_get_us();
+	ent->type = type;
+	ent->val = val;
+}
+
+#ifdef DEBUG
+/* Training steps announced by the major messages, see DWC PHY training firmware */
+static const char *ddr_train_step_name(u32 mail)
+{
+	switch (mail) {
+	case 0x00:
+		return "init";
+	case 0x01:
+		return "fine write leveling";
+	case 0x02:
+		return "read enable";
+	case 0x03:
+		return "read delay center";
+	case 0x04:
+		return "write delay center";
+	case 0x05:
+		return "2D read delay/voltage center";
+	case 0x06:
+		return "2D write delay/voltage center";
+	case 0x07:
+		return "complete";
+	case 0x09:
+		return "max read latency";
+	case 0x0a:
+		return "read dq deskew";
+	case 0x0c:
+		return "DB training";
+	case 0x0d:
+		return "CA training";
+	case 0xfd:
+		return "MPR read delay center";
+	case 0xfe:
+		return "coarse write leveling";
+	case 0xff:
+		return "FAILED";
+	default:
+		return "unknown";
+	}
+}
+
+/**
+ * Print the duration of each training step, from the previous major
+ * message or the start of the firmware run to the major message ending it.
+ */
+void ddr_train_log_summary(void)
+{
+	struct ddr_train_log_ent *ent = train_log->ent;
+	u32 i, start = 0, msgs = 0;
+
+	for (i = 0; i < train_log->num; i++, ent++) {
+		switch (ent->type) {
+		case DDR_TRAIN_LOG_RUN:
+			printf("** DDR OEI: firmware run at %u MT/s **\n", ent->val);
+			start = ent->ts;
+			msgs = 0;
+			break;
+		case DDR_TRAIN_LOG_STEPS:
+			printf("   SequenceCtrl 0x%x\n", ent->val);
+			break;
+		case DDR_TRAIN_LOG_MAJOR:
+			if (ent->val == 0x08)
+				break;
+			printf("   %s: %u us, %u messages\n", ddr_train_step_name(ent->val),
+			       ent->ts - start, msgs);
+			start = ent->ts;
+			msgs = 0;
+			break;
+		case DDR_TRAIN_LOG_STRING:
+			msgs++;
+			break;
+		default:
+			break;
+		}
+	}
+
+	if (train_log->lost)
+		printf("** DDR OEI: %u training log entries lost **\n", train_log->lost);
+}
+#endif
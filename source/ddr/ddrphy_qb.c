@@ -6,6 +6,7 @@
 #include <errno.h>
 #include "crc.h"
 #include "ddr.h"
+#include "ddr/qb_p230_rldb4_csr.h"
 #include "debug.h"
 #include "time.h"
 #if defined(DDR4x)
@@ -29,68 +30,190 @@ static void ddrphy_delay40(unsigned int drate)
 #endif
 }
 
-static void ddrphy_prepare_mb(u16 *mb, struct dram_fsp_msg *fsp_msg)
+#if defined(CONFIG_DDR_QB_COMPRESS)
+#define DDRPHY_QB_FLAGS		DDRPHY_QB_F_RLE
+#else
+#define DDRPHY_QB_FLAGS		0
+#endif
+
+/* Raw size of each section in bytes, the MR one for each FSP */
+static const u32 ddrphy_qb_sect_raw[DDRPHY_QB_SECT_NUM] = {
+	sizeof(ddrphy_qb_mr),
+	DDRPHY_QB_CSR_SIZE * sizeof(u16),
+	DDRPHY_QB_ACSM_SIZE * sizeof(u16),
+	DDRPHY_QB_PST_SIZE * sizeof(u16),
+};
+
+/**
+ * Check the header only, a state saved by another layout, for another
+ * DRAM type, FSP data rates or CSR save list is rejected before any
+ * section is read
+ */
+static int ddrphy_qb_check_hdr(ddrphy_qb_hdr *hdr, struct dram_timing_info *dtiming)
 {
-	u32 i, idx;
-	struct ddrphy_cfg_param *cfg;
+	struct ddrphy_qb_sect *sect;
+	u32 id, max;
+
+	if (hdr->magic != DDRPHY_QB_MAGIC || hdr->version != DDRPHY_QB_VERSION ||
+	    hdr->flags != DDRPHY_QB_FLAGS || hdr->ddr_type != DDRPHY_QB_DDR_TYPE ||
+	    hdr->fsp_num != dtiming->fsp_msg_num || hdr->fsp_num > DDRPHY_QB_FSP_MAX ||
+	    hdr->csr_hash != DDRPHY_QB_CSR_HASH)
+		return -EINVAL;
+
+	for (id = 0; id < hdr->fsp_num; id++)
+		if (hdr->drate[id] != dtiming->fsp_msg[id].drate)
+			return -EINVAL;
+
+	if (hdr->crc != crc32(hdr, sizeof(*hdr) - sizeof(u32)))
+		return -EINVAL;
+
+	if (hdr->slot >= DDRPHY_QB_SLOTS || hdr->size < sizeof(*hdr) ||
+	    hdr->size % sizeof(u32) || hdr->size > DDRPHY_QB_STATE_MAX)
+		return -EINVAL;
+
+	for (id = 0; id < DDRPHY_QB_SECT_NUM; id++) {
+		sect = &hdr->sect[id];
+		max = ddrphy_qb_sect_raw[id];
+		if (id == DDRPHY_QB_SECT_MR)
+			max *= hdr->fsp_num;
+#if defined(CONFIG_DDR_QB_COMPRESS)
+		/* one token more per started 32K halfwords at most */
+		if (id != DDRPHY_QB_SECT_MR)
+			max += (max / sizeof(u16) + DDRPHY_QB_RLE_RUN - 1) / DDRPHY_QB_RLE_RUN *
+			       sizeof(u16);
+		if (sect->size > max || sect->size % sizeof(u16) ||
+		    (id == DDRPHY_QB_SECT_MR && sect->size != max))
+			return -EINVAL;
+#else
+		if (sect->size != max)
+			return -EINVAL;
+#endif
+		if (sect->offset < sizeof(*hdr) || sect->offset % sizeof(u32) ||
+		    sect->offset > DDRPHY_QB_STATE_MAX - sect->size)
+			return -EINVAL;
+	}
 
-	if (fsp_msg == NULL || fsp_msg->fsp_phy_msgh_cfg == NULL)
-		return;
+	return 0;
+}
+
+static void *ddrphy_qb_sect(ddrphy_qb_hdr *hdr, u32 id)
+{
+	return (u8 *)hdr + hdr->sect[id].offset;
+}
+
+/* Check the CRCs of sections first to last */
+static bool ddrphy_qb_sects_ok(ddrphy_qb_hdr *hdr, u32 first, u32 last)
+{
+	u32 id;
+
+	for (id = first; id <= last; id++)
+		if (crc32(ddrphy_qb_sect(hdr, id), hdr->sect[id].size) != hdr->sect[id].crc)
+			return false;
+
+	return true;
+}
 
-	cfg = fsp_msg->fsp_phy_msgh_cfg;
-	for (i = 0; i < fsp_msg->fsp_phy_msgh_cfg_num; i++, cfg++) {
-		if ((cfg->reg & 0xff000) != DMEM_OFFSET_ADDR)
+/**
+ * Committed states of the image slots matching this image and its FSPs,
+ * newest generation first, returns their number
+ */
+u32 ddrphy_qb_slots(ddrphy_qb_hdr **slots, struct dram_timing_info *dtiming)
+{
+	u32 qb_state_addr = ddr_get_qb_state_addr();
+	ddrphy_qb_hdr *hdr;
+	u32 i, num = 0;
+	u32 *commit;
+
+	for (i = 0; i < DDRPHY_QB_SLOTS; i++) {
+		hdr = (ddrphy_qb_hdr *)(qb_state_addr + i * DDRPHY_QB_SLOT_SIZE);
+		if (ddrphy_qb_check_hdr(hdr, dtiming) || hdr->slot != i ||
+		    hdr->gen == DDRPHY_QB_GEN_NONE)
 			continue;
-		idx = (cfg->reg & 0xfff);
-		if (idx >= DDRPHY_QB_MSB_SIZE)
+
+		commit = (void *)((u8 *)hdr + hdr->size);
+		if (*commit != ~hdr->crc)
 			continue;
-		mb[idx] = cfg->val;
+
+		slots[num++] = hdr;
+	}
+
+	/*
+	 * generations wrap around, equal ones (never written by the training
+	 * flow nor ddr_qb_stamp.py) keep slot 0 first
+	 */
+	if (num == 2 && (int32)(slots[1]->gen - slots[0]->gen) > 0) {
+		hdr = slots[0];
+		slots[0] = slots[1];
+		slots[1] = hdr;
+	}
+
+	return num;
+}
+
+#if defined(CONFIG_DDR_QB_COMPRESS)
+/* Decode num halfwords of a state section to the PHY, from APB address addr on */
+static void ddrphy_qb_rle_unpack(const u16 *src, u32 addr, u32 num)
+{
+	u32 tok, cnt, end = addr + num;
+	u16 val;
+
+	while (addr < end) {
+		tok = *src++;
+		cnt = (tok & (DDRPHY_QB_RLE_RUN - 1)) + 1;
+		if (cnt > end - addr)
+			cnt = end - addr;
+
+		if (tok & DDRPHY_QB_RLE_RUN) {
+			val = *src++;
+			while (cnt--)
+				dwc_ddrphy_apb_wr(addr++, val);
+		} else {
+			while (cnt--)
+				dwc_ddrphy_apb_wr(addr++, *src++);
+		}
 	}
 }
+#endif
 
-static int ddrphy_qb_restore(u16 *mb, struct dram_fsp_msg *fsp_msg, ddrphy_qb_state *qb_state)
+static int ddrphy_qb_restore(u16 *mb, struct dram_fsp_msg *fsp_msg, const ddrphy_qb_mr *mr)
 {
-	u32 i;
 #if defined(DDR4x)
 	MSB_DDR4X_t *msb = (MSB_DDR4X_t *)(mb);
 #elif defined(DDR5)
 	MSB_DDR5_t *msb = (MSB_DDR5_t *)(mb);
 #endif
-	for (i = 0; i < DDRPHY_QB_MSB_SIZE; i++)
-		mb[i] = 0;
-
 	ddrphy_prepare_mb(mb, fsp_msg);
 
 	msb->SequenceCtrl = 0x01; /* SequenceCtrl = 0x1 (DevInit Only)*/
 	msb->Quickboot    = 0x01; /* Quickboot    = 0x1 */
 
 #if (defined(DDR4x) || defined(DDR5))
-	msb->MR12_A0 = qb_state->TrainedVREFCA_A0;
-	msb->MR12_A1 = qb_state->TrainedVREFCA_A1;
-	msb->MR12_B0 = qb_state->TrainedVREFCA_B0;
-	msb->MR12_B1 = qb_state->TrainedVREFCA_B1;
+	msb->MR12_A0 = mr->TrainedVREFCA_A0;
+	msb->MR12_A1 = mr->TrainedVREFCA_A1;
+	msb->MR12_B0 = mr->TrainedVREFCA_B0;
+	msb->MR12_B1 = mr->TrainedVREFCA_B1;
 
-	msb->MR14_A0 = qb_state->TrainedVREFDQ_A0;
-	msb->MR14_A1 = qb_state->TrainedVREFDQ_A1;
-	msb->MR14_B0 = qb_state->TrainedVREFDQ_B0;
-	msb->MR14_B1 = qb_state->TrainedVREFDQ_B1;
+	msb->MR14_A0 = mr->TrainedVREFDQ_A0;
+	msb->MR14_A1 = mr->TrainedVREFDQ_A1;
+	msb->MR14_B0 = mr->TrainedVREFDQ_B0;
+	msb->MR14_B1 = mr->TrainedVREFDQ_B1;
 #endif
 
 #if (defined(DDR5))
-	msb->MR15_A0 = qb_state->TrainedVREFDQU_A0;
-	msb->MR15_A1 = qb_state->TrainedVREFDQU_A1;
-	msb->MR15_B0 = qb_state->TrainedVREFDQU_B0;
-	msb->MR15_B1 = qb_state->TrainedVREFDQU_B1;
+	msb->MR15_A0 = mr->TrainedVREFDQU_A0;
+	msb->MR15_A1 = mr->TrainedVREFDQU_A1;
+	msb->MR15_B0 = mr->TrainedVREFDQU_B0;
+	msb->MR15_B1 = mr->TrainedVREFDQU_B1;
 
-	msb->MR24_A0 = qb_state->TrainedDRAMDFE_A0;
-	msb->MR24_A1 = qb_state->TrainedDRAMDFE_A1;
-	msb->MR24_B0 = qb_state->TrainedDRAMDFE_B0;
-	msb->MR24_B1 = qb_state->TrainedDRAMDFE_B1;
+	msb->MR24_A0 = mr->TrainedDRAMDFE_A0;
+	msb->MR24_A1 = mr->TrainedDRAMDFE_A1;
+	msb->MR24_B0 = mr->TrainedDRAMDFE_B0;
+	msb->MR24_B1 = mr->TrainedDRAMDFE_B1;
 
-	msb->MR30_A0 = qb_state->TrainedDRAMDCA_A0;
-	msb->MR30_A1 = qb_state->TrainedDRAMDCA_A1;
-	msb->MR30_B0 = qb_state->TrainedDRAMDCA_B0;
-	msb->MR30_B1 = qb_state->TrainedDRAMDCA_B1;
+	msb->MR30_A0 = mr->TrainedDRAMDCA_A0;
+	msb->MR30_A1 = mr->TrainedDRAMDCA_A1;
+	msb->MR30_B0 = mr->TrainedDRAMDCA_B0;
+	msb->MR30_B1 = mr->TrainedDRAMDCA_B1;
 #endif
 	return 0;
 }
@@ -98,14 +221,54 @@ static int ddrphy_qb_restore(u16 *mb, struct dram_fsp_msg *fsp_msg, ddrphy_qb_st
 #define PUB2_xx	1
 #define PUB2_30	1
 
-int ddr_cfg_phy_qb(struct dram_timing_info *dtiming, int fsp_id)
+/* Steps 3.2.2 and 3.2.3, up to PtrInit */
+static const u16 ddrphy_qb_init_seq[] = {
+	SEQ_PHY_WR(0xd0000, 0x0),
+	SEQ_PHY_WR(0xd0031, 0x1),
+	SEQ_PHY_WR(0xc0080, 0x3), /** 3.2.2.1 Low Speed PMU clock */
+	SEQ_PHY_WR(0xc0086, 0x0), /** 3.2.3   SRAM ECC Initialization off */
+	SEQ_PHY_WR(0x3F0A2, 0x0F00),
+	DDRPHY_BURST(0x3F042, 2), 0x0F0F, 0x0F0F,
+	SEQ_PHY_WR(0x3F0A3, 0x0800),
+#if (defined(PUB1_02) || defined(PUB1_04) || defined(PUB1_05) || defined(PUB2_00))
+	SEQ_PHY_WR(0x3F0AC, 0x07FF),
+	SEQ_PHY_WR(0x1F00F, 0x0006),
+	SEQ_PHY_WR(0x200F8, 0x0000),
+#endif
+	/** Need to wait 30 DFI cycles since PtrInit works after some pipeline. */
+	SEQ_UDELAY(1),
+	SEQ_PHY_WR(0x20090, 0x0001),
+	SEQ_PHY_WR(0x20060, 0x0003),
+};
+
+/* Step I */
+static const u16 ddrphy_qb_hw_seq[] = {
+#if defined(PUB1_xx)
+	SEQ_PHY_WR(0xd00e7, 0x400),
+#elif defined(PUB2_xx)
+	SEQ_PHY_WR(0xd00e7, 0x600),
+#endif
+	SEQ_PHY_WR(0xc0080, 0x2),
+	SEQ_PHY_WR(0xd0000, 0x1),
+};
+
+/**
+ * Restore the saved state of every FSP: the QuickBoot firmware runs once
+ * per FSP in the training order, the last one is fsp_id, the boot FSP
+ */
+int ddr_cfg_phy_qb(struct dram_timing_info *dtiming, int fsp_id, struct ddr_bringup *bu)
 {
 	struct dram_fsp_msg *fsp_msg;
-	ddrphy_qb_state *qb_state;
-	u32 qb_state_addr;
-	unsigned int i;
+#if !defined(CONFIG_DDR_QB_COMPRESS)
+	struct ddrphy_sram_xfer sram;
+#endif
+	struct ddr_fw_xfer xfer;
+	ddrphy_qb_hdr *slots[DDRPHY_QB_SLOTS];
+	ddrphy_qb_hdr *hdr;
+	ddrphy_qb_mr *mr;
+	u32 num, slot, i;
+	bool valid;
 	int ret;
-	u32 to_addr, size, crc;
 	u16 *mb;
 #ifdef DEBUG
 	unsigned int ts, te;
@@ -113,95 +276,139 @@ int ddr_cfg_phy_qb(struct dram_timing_info *dtiming, int fsp_id)
 
 	mb = (u16 *) QB_STATE_MEM;
 	fsp_msg = &dtiming->fsp_msg[fsp_id];
-	qb_state_addr = ddr_get_qb_state_addr();
-	qb_state = (ddrphy_qb_state *)(qb_state_addr);
+	num = ddrphy_qb_slots(slots, dtiming);
+	if (!num)
+		return -EINVAL;
 
-	size = sizeof(ddrphy_qb_state) - sizeof(u32);
-	crc = crc32(&qb_state->TrainedVREFCA_A0, size);
+	/**
+	 * The CRCs of the sections needed before the firmware run are
+	 * checked while the PHY settles and the DRAM PLL locks
+	 */
+	for (slot = 0; slot < num; slot++)
+		if (ddrphy_qb_sects_ok(slots[slot], DDRPHY_QB_SECT_MR, DDRPHY_QB_SECT_CSR))
+			break;
 
-	if (crc != qb_state->crc)
-		return -1;
+	ret = ddr_bringup_clk_ready(bu, NULL);
+	if (ret)
+		return ret;
+
+	if (slot == num)
+		return -EINVAL;
+	hdr = slots[slot];
 
 	/** 3.2.2 MemReset Toggle */
+	ddr_bringup_phy_ready(bu);
 	ddrphy_delay40(fsp_msg->drate);
-	dwc_ddrphy_apb_wr(0xd0000, 0x0);
-	dwc_ddrphy_apb_wr(0xd0031, 0x1);
-	dwc_ddrphy_apb_wr(0xc0080, 0x3); /** 3.2.2.1 Low Speed PMU clock */
-	dwc_ddrphy_apb_wr(0xc0086, 0x0); /** 3.2.3   SRAM ECC Initialization off */
-	dwc_ddrphy_apb_wr(0x3F0A2, 0x0F00);
-	dwc_ddrphy_apb_wr(0x3F042, 0x0F0F);
-	dwc_ddrphy_apb_wr(0x3F043, 0x0F0F);
-	dwc_ddrphy_apb_wr(0x3F0A3, 0x0800);
-#if (defined(PUB1_02) || defined(PUB1_04) || defined(PUB1_05) || defined(PUB2_00))
-	dwc_ddrphy_apb_wr(0x3F0AC, 0x07FF);
-	dwc_ddrphy_apb_wr(0x1F00F, 0x0006);
-	dwc_ddrphy_apb_wr(0x200F8, 0x0000);
-#endif
-	/** Need to wait 30 DFI cycles since PtrInit works after some pipeline. */
-	udelay(1);
-	dwc_ddrphy_apb_wr(0x20090, 0x0001);
-	dwc_ddrphy_apb_wr(0x20060, 0x0003);
+	ret = ddr_seq_exec(ddrphy_qb_init_seq);
+	if (ret)
+		return ret;
 
 #ifdef DEBUG
 	ts = timer_get_us();
 #endif
-	/** 3.2.4 Step D Load QuickBoot IMEM */
-	ddr_load_train_firmware(NULL, IMEM);
+	/**
+	 * 3.2.4 Step D Load QuickBoot IMEM, the DMEM message block of
+	 * the first FSP is built and the SRAM sections are checked while
+	 * an eDMA transfer is running
+	 */
+	ddr_fw_xfer_start(&xfer, IMEM);
+	mr = ddrphy_qb_sect(hdr, DDRPHY_QB_SECT_MR);
+	ddrphy_qb_restore(mb, dtiming->fsp_msg, mr);
+	valid = ddrphy_qb_sects_ok(hdr, DDRPHY_QB_SECT_ACSM, DDRPHY_QB_SECT_PST);
+	/* the older slot is used when the SRAM sections of the newer one are corrupted */
+	if (!valid && ++slot < num &&
+	    ddrphy_qb_sects_ok(slots[slot], DDRPHY_QB_SECT_MR, DDRPHY_QB_SECT_PST)) {
+		hdr = slots[slot];
+		mr = ddrphy_qb_sect(hdr, DDRPHY_QB_SECT_MR);
+		ddrphy_qb_restore(mb, dtiming->fsp_msg, mr);
+		valid = true;
+	}
+	ddr_fw_xfer_wait(&xfer);
+	if (!valid)
+		return -EINVAL;
 #ifdef DEBUG
+	printf("** DDR OEI: QuickBoot state slot %u, generation %u **\n", hdr->slot, hdr->gen);
 	te = timer_get_us() - ts;
 	printf("** DDR OEI: IMEM load in %u us **\n", te);
-	ts = timer_get_us();
 #endif
-	/** 3.2.5 Step F Load QuickBoot DMEM */
-	ddrphy_qb_restore(mb, fsp_msg, qb_state);
-	ddr_load_DMEM(mb, qb_state);
+
+	ddr_train_log_init();
+	for (i = 0; i < dtiming->fsp_msg_num; i++) {
+		fsp_msg = &dtiming->fsp_msg[i];
+		if (i)
+			ddrphy_qb_restore(mb, fsp_msg, &mr[i]);
+
+		/* the DFI clock already runs at the boot FSP rate with a single FSP */
+		if (dtiming->fsp_msg_num > 1) {
+			ret = ddrphy_init_set_dfi_clk(fsp_msg->drate);
+			if (ret)
+				return ret;
+		}
 #ifdef DEBUG
-	te = timer_get_us() - ts;
-	printf("** DDR OEI: DMEM load in %u us **\n", te);
-	ts = timer_get_us();
+		ts = timer_get_cycles();
+#endif
+		/** 3.2.5 Step F Load QuickBoot DMEM */
+#if defined(CONFIG_DDR_QB_COMPRESS)
+		ddrphy_qb_rle_unpack(ddrphy_qb_sect(hdr, DDRPHY_QB_SECT_CSR),
+				     DMEM_OFFSET_ADDR + DDRPHY_QB_MSB_SIZE, DDRPHY_QB_CSR_SIZE);
+		ddr_load_DMEM(mb, NULL);
+#else
+		ddr_load_DMEM(mb, ddrphy_qb_sect(hdr, DDRPHY_QB_SECT_CSR));
 #endif
-	/* excute the firmware */
-	dwc_ddrphy_apb_wr(0xd0000, 0x1); /* CSR bus: MCU/PIE/DMA++,TDR/APB-- */
-	dwc_ddrphy_apb_wr(0xd0099, 0x9);
-	dwc_ddrphy_apb_wr(0xd0099, 0x1);
-	dwc_ddrphy_apb_wr(0xd0099, 0x0);
+#ifdef DEBUG
+		te = timer_cycles_to_ns(timer_get_cycles() - ts);
+		printf("** DDR OEI: DMEM load in %u.%03u us **\n", te / 1000, te % 1000);
+		ts = timer_get_us();
+#endif
+		/* excute the firmware */
+		ddr_train_log(DDR_TRAIN_LOG_RUN, fsp_msg->drate);
+		ret = ddrphy_pmu_run();
+		if (ret) {
+			ddr_train_log_summary();
+			return ret;
+		}
 
-	/* Wait for the quick boot firmware to complete */
-	ret = wait_ddrphy_training_complete();
-	if (ret)
-		return ret;
+		/* Halt the microcontroller. */
+		dwc_ddrphy_apb_wr(0xd0099, 0x1);
+		ddrphy_delay40(fsp_msg->drate);
+		dwc_ddrphy_apb_wr(0xd0000, 0x0); /* CSR bus: MCU--,PIE/DMA/TDR/APB++ */
+#ifdef DEBUG
+		te = timer_get_us() - ts;
+		printf("** DDR OEI: Quickboot FW run at %u MT/s complete in %u us **\n",
+		       fsp_msg->drate, te);
+#endif
+	}
+	ddr_train_log_summary();
 
-	/* Halt the microcontroller. */
-	dwc_ddrphy_apb_wr(0xd0099, 0x1);
-	ddrphy_delay40(fsp_msg->drate);
-	dwc_ddrphy_apb_wr(0xd0000, 0x0); /* CSR bus: MCU--,PIE/DMA/TDR/APB++ */
 #ifdef DEBUG
-	te = timer_get_us() - ts;
-	printf("** DDR OEI: Quickboot FW run complete in %u us **\n", te);
-	ts = timer_get_us();
+	ts = timer_get_cycles();
+#endif
+	/** 3.2.7 Step H Restore SRAM data, by eDMA when enabled */
+#if defined(CONFIG_DDR_QB_COMPRESS)
+	ddrphy_qb_rle_unpack(ddrphy_qb_sect(hdr, DDRPHY_QB_SECT_ACSM), ACSM_SRAM_BASE_ADDR,
+			     DDRPHY_QB_ACSM_SIZE);
+#else
+	ddrphy_sram_xfer_start(&sram, ddrphy_qb_sect(hdr, DDRPHY_QB_SECT_ACSM), ACSM_SRAM_BASE_ADDR,
+			       DDRPHY_QB_ACSM_SIZE, true);
+	ddrphy_sram_xfer_wait(&sram);
 #endif
-	/** 3.2.7 Step H Restore SRAM data */
-	for (i = 0, to_addr = ACSM_SRAM_BASE_ADDR; i < DDRPHY_QB_ACSM_SIZE; i++, to_addr++)
-		dwc_ddrphy_apb_wr(to_addr, qb_state->acsm[i]);
 #ifdef DEBUG
-	te = timer_get_us() - ts;
-	printf("** DDR OEI: ACSM SRAM restore in %u us **\n", te);
-	ts = timer_get_us();
+	te = timer_cycles_to_ns(timer_get_cycles() - ts);
+	printf("** DDR OEI: ACSM SRAM restore in %u.%03u us **\n", te / 1000, te % 1000);
+	ts = timer_get_cycles();
+#endif
+#if defined(CONFIG_DDR_QB_COMPRESS)
+	ddrphy_qb_rle_unpack(ddrphy_qb_sect(hdr, DDRPHY_QB_SECT_PST), PSTATE_SRAM_BASE_ADDR,
+			     DDRPHY_QB_PST_SIZE);
+#else
+	ddrphy_sram_xfer_start(&sram, ddrphy_qb_sect(hdr, DDRPHY_QB_SECT_PST), PSTATE_SRAM_BASE_ADDR,
+			       DDRPHY_QB_PST_SIZE, true);
+	ddrphy_sram_xfer_wait(&sram);
 #endif
-	for (i = 0, to_addr = PSTATE_SRAM_BASE_ADDR; i < DDRPHY_QB_PST_SIZE; i++, to_addr++)
-		dwc_ddrphy_apb_wr(to_addr, qb_state->pst[i]);
 #ifdef DEBUG
-	te = timer_get_us() - ts;
-	printf("** DDR OEI: PSTATE SRAM restore in %u us **\n", te);
+	te = timer_cycles_to_ns(timer_get_cycles() - ts);
+	printf("** DDR OEI: PSTATE SRAM restore in %u.%03u us **\n", te / 1000, te % 1000);
 #endif
 	/** 3.2.8 Step I Configure PHY for Hardware */
-#if defined(PUB1_xx)
-	dwc_ddrphy_apb_wr(0xd00e7, 0x400);
-#elif defined(PUB2_xx)
-	dwc_ddrphy_apb_wr(0xd00e7, 0x600);
-#endif
-	dwc_ddrphy_apb_wr(0xc0080, 0x2);
-	dwc_ddrphy_apb_wr(0xd0000, 0x1);
-
-	return 0;
+	return ddr_seq_exec(ddrphy_qb_hw_seq);
 }
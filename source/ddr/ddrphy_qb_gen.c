@@ -3,9 +3,52 @@
  * Copyright 2023 NXP
  */
 #include "crc.h"
-#include "ddr/qb_p230_rldb4.h"
+#include "ddr/qb_p230_rldb4_csr.h"
+#include "debug.h"
 #include "time.h"
 
+/* Position in the CSR save list */
+struct ddrphy_csr_iter {
+	const struct ddrphy_csr_grp *grp;
+	const struct ddrphy_csr_run *run;	/* first run of grp */
+	u32 inst;
+	u32 r;
+	u32 i;
+};
+
+static void ddrphy_csr_first(struct ddrphy_csr_iter *it)
+{
+	it->grp = ddrphy_csr_grps;
+	it->run = ddrphy_csr_runs;
+	it->inst = 0;
+	it->r = 0;
+	it->i = 0;
+}
+
+/* PHY address of the next CSR to save, DDRPHY_QB_CSR_SIZE in total */
+static u32 ddrphy_csr_next(struct ddrphy_csr_iter *it)
+{
+	const struct ddrphy_csr_run *run = &it->run[it->r];
+	u32 addr = run->base + it->inst * it->grp->inst_stride + it->i * run->stride;
+
+	if (++it->i < run->count)
+		return addr;
+
+	it->i = 0;
+	if (++it->r < it->grp->runs)
+		return addr;
+
+	it->r = 0;
+	if (++it->inst < it->grp->inst)
+		return addr;
+
+	it->inst = 0;
+	it->run += it->grp->runs;
+	it->grp++;
+
+	return addr;
+}
+
 static u8 ddrphy_read_mb_u8(u32 offset)
 {
 	u8 ret;
@@ -26,10 +69,156 @@ static u8 ddrphy_read_mb_u8(u32 offset)
 	return ret;
 }
 
-void ddrphy_qb_save(void)
+#if defined(CONFIG_DDR_QB_COMPRESS)
+/* Run-length encoder state, see DDRPHY_QB_RLE_RUN */
+struct ddrphy_qb_rle {
+	u16 *out;
+	u16 *lit;	/* token of the open literal run, NULL if none */
+	u32 run;	/* pending repeats of val */
+	u16 val;
+};
+
+static void ddrphy_qb_rle_lit(struct ddrphy_qb_rle *rle, u16 val)
+{
+	if (rle->lit && *rle->lit < DDRPHY_QB_RLE_RUN - 1) {
+		(*rle->lit)++;
+	} else {
+		rle->lit = rle->out++;
+		*rle->lit = 0;
+	}
+	*rle->out++ = val;
+}
+
+/* Emit the pending run, shorter runs are cheaper as literals */
+static void ddrphy_qb_rle_flush(struct ddrphy_qb_rle *rle)
+{
+	u32 i;
+
+	if (rle->run >= 3) {
+		*rle->out++ = DDRPHY_QB_RLE_RUN | (rle->run - 1);
+		*rle->out++ = rle->val;
+		rle->lit = NULL;
+	} else {
+		for (i = 0; i < rle->run; i++)
+			ddrphy_qb_rle_lit(rle, rle->val);
+	}
+	rle->run = 0;
+}
+
+static void ddrphy_qb_rle_put(struct ddrphy_qb_rle *rle, u16 val)
+{
+	if (rle->run && (val != rle->val || rle->run == DDRPHY_QB_RLE_RUN))
+		ddrphy_qb_rle_flush(rle);
+	rle->val = val;
+	rle->run++;
+}
+
+/**
+ * Encode num PHY registers from APB address addr on, or from the CSR save
+ * list, returns the size of the encoded section in bytes
+ */
+static u32 ddrphy_qb_rle_section(u16 *out, struct ddrphy_csr_iter *csr, u32 addr, u32 num)
+{
+	struct ddrphy_qb_rle rle;
+	u32 i;
+
+	rle.out = out;
+	rle.lit = NULL;
+	rle.run = 0;
+	rle.val = 0;
+
+	for (i = 0; i < num; i++)
+		ddrphy_qb_rle_put(&rle, dwc_ddrphy_apb_rd(csr ? ddrphy_csr_next(csr) : addr + i));
+	ddrphy_qb_rle_flush(&rle);
+
+	return (rle.out - out) * sizeof(u16);
+}
+#endif
+
+/* Place section id at data, returns where the next section starts, 4 bytes aligned */
+static void *ddrphy_qb_sect_add(ddrphy_qb_hdr *hdr, u32 id, void *data, u32 size)
+{
+	hdr->sect[id].offset = (u8 *)data - (u8 *)hdr;
+	hdr->sect[id].size = size;
+
+	return (u8 *)data + ((size + 3) & ~3U);
+}
+
+static void ddrphy_qb_sect_crc(ddrphy_qb_hdr *hdr, u32 id)
 {
-	u32 i, addr, mux, ucc, size;
-	ddrphy_qb_state *qb_state = (ddrphy_qb_state *) QB_STATE_MEM;
+	struct ddrphy_qb_sect *sect = &hdr->sect[id];
+
+	sect->crc = crc32((u8 *)hdr + sect->offset, sect->size);
+}
+
+/**
+ * Save the trained values of the FSP trained last from the Message Block
+ * area, the PMU is halted
+ */
+void ddrphy_qb_read_mr(ddrphy_qb_mr *mr)
+{
+	u32 ucc;
+
+	ucc = dwc_ddrphy_apb_rd(0xc0080);
+	dwc_ddrphy_apb_wr(0xc0080, 0x3);
+
+#if defined(DDR4x)
+	mr->TrainedVREFCA_A0 = ddrphy_read_mb_u8(0x4b);
+	mr->TrainedVREFCA_A1 = ddrphy_read_mb_u8(0x4c);
+	mr->TrainedVREFCA_B0 = ddrphy_read_mb_u8(0x7e);
+	mr->TrainedVREFCA_B1 = ddrphy_read_mb_u8(0x7f);
+
+	mr->TrainedVREFDQ_A0 = ddrphy_read_mb_u8(0x4d);
+	mr->TrainedVREFDQ_A1 = ddrphy_read_mb_u8(0x4e);
+	mr->TrainedVREFDQ_B0 = ddrphy_read_mb_u8(0x80);
+	mr->TrainedVREFDQ_B1 = ddrphy_read_mb_u8(0x81);
+#elif defined(DDR5)
+	mr->TrainedVREFCA_A0 = ddrphy_read_mb_u8(0x33);
+	mr->TrainedVREFCA_A1 = ddrphy_read_mb_u8(0x34);
+	mr->TrainedVREFCA_B0 = ddrphy_read_mb_u8(0x4e);
+	mr->TrainedVREFCA_B1 = ddrphy_read_mb_u8(0x4f);
+
+	mr->TrainedVREFDQ_A0 = ddrphy_read_mb_u8(0x35);
+	mr->TrainedVREFDQ_A1 = ddrphy_read_mb_u8(0x36);
+	mr->TrainedVREFDQ_B0 = ddrphy_read_mb_u8(0x50);
+	mr->TrainedVREFDQ_B1 = ddrphy_read_mb_u8(0x51);
+
+	mr->TrainedVREFDQU_A0 = ddrphy_read_mb_u8(0xd0);
+	mr->TrainedVREFDQU_A1 = ddrphy_read_mb_u8(0xd5);
+	mr->TrainedVREFDQU_B0 = ddrphy_read_mb_u8(0xda);
+	mr->TrainedVREFDQU_B1 = ddrphy_read_mb_u8(0xdf);
+
+	mr->TrainedDRAMDFE_A0 = ddrphy_read_mb_u8(0xd1);
+	mr->TrainedDRAMDFE_A1 = ddrphy_read_mb_u8(0xd6);
+	mr->TrainedDRAMDFE_B0 = ddrphy_read_mb_u8(0xdb);
+	mr->TrainedDRAMDFE_B1 = ddrphy_read_mb_u8(0xe0);
+
+	mr->TrainedDRAMDCA_A0 = ddrphy_read_mb_u8(0xd2);
+	mr->TrainedDRAMDCA_A1 = ddrphy_read_mb_u8(0xd7);
+	mr->TrainedDRAMDCA_B0 = ddrphy_read_mb_u8(0xdc);
+	mr->TrainedDRAMDCA_B1 = ddrphy_read_mb_u8(0xe1);
+#endif
+
+	dwc_ddrphy_apb_wr(0xc0080, ucc);
+}
+
+void ddrphy_qb_save(struct dram_timing_info *dtiming, ddrphy_qb_mr *mr)
+{
+	ddrphy_qb_hdr *hdr = (ddrphy_qb_hdr *) QB_STATE_MEM;
+	struct ddrphy_csr_iter csr;
+#if !defined(CONFIG_DDR_QB_COMPRESS)
+	struct ddrphy_sram_xfer xfer;
+	u16 *sram;
+#endif
+#if defined(DDR_QB_FLOW)
+	ddrphy_qb_hdr *slots[DDRPHY_QB_SLOTS];
+#endif
+	u32 mux, ucc, size, i;
+	u32 *commit;
+	void *data;
+#ifdef DEBUG
+	u32 ts = timer_get_us();
+#endif
 
 	/* enable the ddrphy apb */
 	mux = dwc_ddrphy_apb_rd(0xd0000);
@@ -38,67 +227,98 @@ void ddrphy_qb_save(void)
 	dwc_ddrphy_apb_wr(0xd0000, 0x0);
 	dwc_ddrphy_apb_wr(0xc0080, 0x3);
 
-	/* Save trained values from Message Block area */
-#if defined(DDR4x)
-	qb_state->TrainedVREFCA_A0 = ddrphy_read_mb_u8(0x4b);
-	qb_state->TrainedVREFCA_A1 = ddrphy_read_mb_u8(0x4c);
-	qb_state->TrainedVREFCA_B0 = ddrphy_read_mb_u8(0x7e);
-	qb_state->TrainedVREFCA_B1 = ddrphy_read_mb_u8(0x7f);
-
-	qb_state->TrainedVREFDQ_A0 = ddrphy_read_mb_u8(0x4d);
-	qb_state->TrainedVREFDQ_A1 = ddrphy_read_mb_u8(0x4e);
-	qb_state->TrainedVREFDQ_B0 = ddrphy_read_mb_u8(0x80);
-	qb_state->TrainedVREFDQ_B1 = ddrphy_read_mb_u8(0x81);
-#elif defined(DDR5)
-	qb_state->TrainedVREFCA_A0 = ddrphy_read_mb_u8(0x33);
-	qb_state->TrainedVREFCA_A1 = ddrphy_read_mb_u8(0x34);
-	qb_state->TrainedVREFCA_B0 = ddrphy_read_mb_u8(0x4e);
-	qb_state->TrainedVREFCA_B1 = ddrphy_read_mb_u8(0x4f);
-
-	qb_state->TrainedVREFDQ_A0 = ddrphy_read_mb_u8(0x35);
-	qb_state->TrainedVREFDQ_A1 = ddrphy_read_mb_u8(0x36);
-	qb_state->TrainedVREFDQ_B0 = ddrphy_read_mb_u8(0x50);
-	qb_state->TrainedVREFDQ_B1 = ddrphy_read_mb_u8(0x51);
-
-	qb_state->TrainedVREFDQU_A0 = ddrphy_read_mb_u8(0xd0);
-	qb_state->TrainedVREFDQU_A1 = ddrphy_read_mb_u8(0xd5);
-	qb_state->TrainedVREFDQU_B0 = ddrphy_read_mb_u8(0xda);
-	qb_state->TrainedVREFDQU_B1 = ddrphy_read_mb_u8(0xdf);
-
-	qb_state->TrainedDRAMDFE_A0 = ddrphy_read_mb_u8(0xd1);
-	qb_state->TrainedDRAMDFE_A1 = ddrphy_read_mb_u8(0xd6);
-	qb_state->TrainedDRAMDFE_B0 = ddrphy_read_mb_u8(0xdb);
-	qb_state->TrainedDRAMDFE_B1 = ddrphy_read_mb_u8(0xe0);
-
-	qb_state->TrainedDRAMDCA_A0 = ddrphy_read_mb_u8(0xd2);
-	qb_state->TrainedDRAMDCA_A1 = ddrphy_read_mb_u8(0xd7);
-	qb_state->TrainedDRAMDCA_B0 = ddrphy_read_mb_u8(0xdc);
-	qb_state->TrainedDRAMDCA_B1 = ddrphy_read_mb_u8(0xe1);
-#endif
+	/* Trained values of each FSP, read after its training run */
+	size = dtiming->fsp_msg_num * sizeof(*mr);
+	data = hdr + 1;
+	for (i = 0; i < size; i++)
+		((u8 *)data)[i] = ((u8 *)mr)[i];
+	data = ddrphy_qb_sect_add(hdr, DDRPHY_QB_SECT_MR, data, size);
+
+	ddrphy_csr_first(&csr);
+#if defined(CONFIG_DDR_QB_COMPRESS)
+	/* CSRs, ACSM and PState SRAM are read straight into the encoder */
+	i = ddrphy_qb_rle_section(data, &csr, 0, DDRPHY_QB_CSR_SIZE);
+	data = ddrphy_qb_sect_add(hdr, DDRPHY_QB_SECT_CSR, data, i);
+	i = ddrphy_qb_rle_section(data, NULL, ACSM_SRAM_BASE_ADDR, DDRPHY_QB_ACSM_SIZE);
+	data = ddrphy_qb_sect_add(hdr, DDRPHY_QB_SECT_ACSM, data, i);
+	i = ddrphy_qb_rle_section(data, NULL, PSTATE_SRAM_BASE_ADDR, DDRPHY_QB_PST_SIZE);
+	data = ddrphy_qb_sect_add(hdr, DDRPHY_QB_SECT_PST, data, i);
+
+	for (i = 0; i < DDRPHY_QB_SECT_NUM; i++)
+		ddrphy_qb_sect_crc(hdr, i);
+#else
 	/* Save CSRs */
+	sram = data;
 	for (i = 0; i < DDRPHY_QB_CSR_SIZE; i++)
-		qb_state->csr[i] = dwc_ddrphy_apb_rd(ddrphy_csr_cfg[i]);
+		sram[i] = dwc_ddrphy_apb_rd(ddrphy_csr_next(&csr));
+	data = ddrphy_qb_sect_add(hdr, DDRPHY_QB_SECT_CSR, data, DDRPHY_QB_CSR_SIZE * sizeof(u16));
 
 	/**
-	 * Read ACSM SRAM area and save it to non-volatile storage.
-	 * Psuedo code provided to save ACSM SRAM as follows:
-	 * where ACSM_SRAM_BASE_ADDR is 0x41000
+	 * Read ACSM SRAM area and save it to non-volatile storage,
+	 * where ACSM_SRAM_BASE_ADDR is 0x41000. With eDMA the SRAM
+	 * is read while the CRCs of the sections saved so far run.
 	 */
-	for (i = 0, addr = ACSM_SRAM_BASE_ADDR; i < DDRPHY_QB_ACSM_SIZE; i++, addr++)
-		qb_state->acsm[i] = dwc_ddrphy_apb_rd(addr);
+	ddrphy_sram_xfer_start(&xfer, data, ACSM_SRAM_BASE_ADDR,
+			       DDRPHY_QB_ACSM_SIZE, false);
+	data = ddrphy_qb_sect_add(hdr, DDRPHY_QB_SECT_ACSM, data, DDRPHY_QB_ACSM_SIZE * sizeof(u16));
+	ddrphy_qb_sect_crc(hdr, DDRPHY_QB_SECT_MR);
+	ddrphy_qb_sect_crc(hdr, DDRPHY_QB_SECT_CSR);
+	ddrphy_sram_xfer_wait(&xfer);
 
 	/**
 	 * Read PState SRAM area and save it to non-volatile storage only
-	 * if there is more than 2 PState. Psuedo code provide to save
-	 * PState SRAM as follows, where PSTATE_SRAM_BASE_ADDR is 0xA0000
+	 * if there is more than 2 PState, where PSTATE_SRAM_BASE_ADDR
+	 * is 0xA0000
 	 */
-	for (i = 0, addr = PSTATE_SRAM_BASE_ADDR; i < DDRPHY_QB_PST_SIZE; i++, addr++)
-		qb_state->pst[i] = dwc_ddrphy_apb_rd(addr);
+	ddrphy_sram_xfer_start(&xfer, data, PSTATE_SRAM_BASE_ADDR,
+			       DDRPHY_QB_PST_SIZE, false);
+	data = ddrphy_qb_sect_add(hdr, DDRPHY_QB_SECT_PST, data, DDRPHY_QB_PST_SIZE * sizeof(u16));
+	ddrphy_qb_sect_crc(hdr, DDRPHY_QB_SECT_ACSM);
+	ddrphy_sram_xfer_wait(&xfer);
+	ddrphy_qb_sect_crc(hdr, DDRPHY_QB_SECT_PST);
+#endif
 
-	size = sizeof(ddrphy_qb_state) - sizeof(u32);
-	qb_state->crc = crc32(&qb_state->TrainedVREFCA_A0, size);
+	hdr->magic = DDRPHY_QB_MAGIC;
+	hdr->version = DDRPHY_QB_VERSION;
+#if defined(CONFIG_DDR_QB_COMPRESS)
+	hdr->flags = DDRPHY_QB_F_RLE;
+#else
+	hdr->flags = 0;
+#endif
+	hdr->ddr_type = DDRPHY_QB_DDR_TYPE;
+	hdr->fsp_num = dtiming->fsp_msg_num;
+	for (i = 0; i < DDRPHY_QB_FSP_MAX; i++)
+		hdr->drate[i] = i < hdr->fsp_num ? dtiming->fsp_msg[i].drate : 0;
+	hdr->csr_hash = DDRPHY_QB_CSR_HASH;
+#if defined(DDR_QB_FLOW)
+	/* the newest state of the image slots is kept, the other slot is written */
+	if (ddrphy_qb_slots(slots, dtiming)) {
+		hdr->gen = slots[0]->gen + 1;
+		hdr->slot = (slots[0]->slot + 1) % DDRPHY_QB_SLOTS;
+	} else {
+		hdr->gen = 1;
+		hdr->slot = 0;
+	}
+#else
+	/* the slots are not in this image, ddr_qb_stamp.py assigns them */
+	hdr->gen = DDRPHY_QB_GEN_NONE;
+	hdr->slot = DDRPHY_QB_SLOT_NONE;
+#endif
+	hdr->size = (u8 *)data - (u8 *)hdr;
+	hdr->crc = crc32(hdr, sizeof(*hdr) - sizeof(u32));
+
+	commit = data;
+	*commit = ~hdr->crc;
 
 	/* restore mux */
 	dwc_ddrphy_apb_wr(0xc0080, ucc);
 	dwc_ddrphy_apb_wr(0xd0000, mux);
+#ifdef DEBUG
+	if (hdr->gen == DDRPHY_QB_GEN_NONE)
+		printf("** DDR OEI: QuickBoot state, %u bytes, saved unstamped in %u us **\n",
+		       hdr->size + sizeof(u32), timer_get_us() - ts);
+	else
+		printf("** DDR OEI: QuickBoot state, %u bytes, saved for slot %u in %u us **\n",
+		       hdr->size + sizeof(u32), hdr->slot, timer_get_us() - ts);
+#endif
 }
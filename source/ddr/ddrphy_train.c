@@ -3,6 +3,7 @@
  * Copyright 2018 NXP
  */
 
+#include <errno.h>
 #include "ddr.h"
 #include "debug.h"
 #include "time.h"
@@ -22,24 +23,47 @@ static void ddrphy_delay40(unsigned int drate)
 #endif
 }
 
-int ddr_cfg_phy(struct dram_timing_info *dtiming)
+/* The trained values of each FSP are read to mr[] for the QuickBoot state */
+int ddr_cfg_phy(struct dram_timing_info *dtiming, struct ddr_bringup *bu, ddrphy_qb_mr *mr)
 {
 	struct dram_fsp_msg *fsp_msg;
+	struct ddr_fw_xfer xfer;
 	unsigned int i;
 	int ret;
 #ifdef DEBUG
 	unsigned int ts, te;
 #endif
 
+	/* from 3 FSPs on the QuickBoot state keeps the PState SRAM of each FSP */
+	if (dtiming->fsp_msg_num > DDRPHY_QB_FSP_MAX ||
+	    (dtiming->fsp_msg_num >= 3 && dtiming->fsp_msg_num > DDRPHY_QB_PSTATES))
+		return -EINVAL;
+
+	/* reject training step selections missing a dependency before touching the PHY */
+	for (i = 0, fsp_msg = dtiming->fsp_msg; i < dtiming->fsp_msg_num; i++, fsp_msg++) {
+		ret = ddrphy_train_steps_check(fsp_msg);
+		if (ret)
+			return ret;
+	}
+
+	ddr_train_log_init();
+
 	/* initialize PHY configuration */
+	ddr_bringup_phy_ready(bu);
 	/* config phy common reg */
-	ddrphy_cfg_set(dtiming->ddrphy_cfg, dtiming->ddrphy_cfg_num);
+	ret = ddrphy_cfg_set(dtiming->ddrphy_cfg, dtiming->ddrphy_cfg_num);
+	if (ret)
+		return ret;
 
-	/* load training firmwrae iMEM */
+	/* load training firmwrae iMEM while the DRAM PLL locks */
 #ifdef DEBUG
 	ts = timer_get_us();
 #endif
-	ddr_load_train_firmware(NULL, IMEM);
+	ddr_fw_xfer_start(&xfer, IMEM);
+	ret = ddr_bringup_clk_ready(bu, &xfer);
+	if (ret)
+		return ret;
+	ddr_fw_xfer_wait(&xfer);
 #ifdef DEBUG
 	te = timer_get_us() - ts;
 	printf("** DDR OEI: IMEM load in %u us **\n", te);
@@ -50,22 +74,26 @@ int ddr_cfg_phy(struct dram_timing_info *dtiming)
 	for (i = 0; i < dtiming->fsp_msg_num; i++) {
 		/* If NumPStates more than 2, StartPsloop "DMA reload" prepare no action required */
 		/* config phy pstate reg */
-		ddrphy_cfg_set(fsp_msg->fsp_phy_cfg, fsp_msg->fsp_phy_cfg_num);
+		ret = ddrphy_cfg_set(fsp_msg->fsp_phy_cfg, fsp_msg->fsp_phy_cfg_num);
+		if (ret)
+			return ret;
 
 		/* If NumPStates more than 2, stopPsloop "DMA reload" prepare
 		 * action is included in end of fsp_phy_cfg  */
 
 		/* set dram PHY input clocks to desired frequency */
-		ddrphy_init_set_dfi_clk(fsp_msg->drate);
+		ret = ddrphy_init_set_dfi_clk(fsp_msg->drate);
+		if (ret)
+			return ret;
 
 		/* load the dram training firmware image */
 #ifdef DEBUG
-		ts = timer_get_us();
+		ts = timer_get_cycles();
 #endif
 		ddr_load_train_firmware(fsp_msg, DMEM);
 #ifdef DEBUG
-		te = timer_get_us() - ts;
-		printf("** DDR OEI: DMEM load in %u us **\n", te);
+		te = timer_cycles_to_ns(timer_get_cycles() - ts);
+		printf("** DDR OEI: DMEM load in %u.%03u us **\n", te / 1000, te % 1000);
 #endif
 
 		/*
@@ -81,15 +109,14 @@ int ddr_cfg_phy(struct dram_timing_info *dtiming)
 #ifdef DEBUG
 		ts = timer_get_us();
 #endif
-		dwc_ddrphy_apb_wr(0xd0000, 0x1); /* CSR bus: MCU/PIE/DMA++,TDR/APB-- */
-		dwc_ddrphy_apb_wr(0xd0099, 0x9);
-		dwc_ddrphy_apb_wr(0xd0099, 0x1);
-		dwc_ddrphy_apb_wr(0xd0099, 0x0);
-
-		/* Wait for the training firmware to complete */
-		ret = wait_ddrphy_training_complete();
-		if (ret)
+		/* Run the training firmware and wait for it to complete */
+		ddr_train_log(DDR_TRAIN_LOG_RUN, fsp_msg->drate);
+		ddr_train_log(DDR_TRAIN_LOG_STEPS, ddrphy_train_steps(fsp_msg));
+		ret = ddrphy_pmu_run();
+		if (ret) {
+			ddr_train_log_summary();
 			return ret;
+		}
 
 		/* Halt the microcontroller. */
 		dwc_ddrphy_apb_wr(0xd0099, 0x1);
@@ -102,20 +129,27 @@ int ddr_cfg_phy(struct dram_timing_info *dtiming)
 
 		/* Read the Message Block results */
 		ddrphy_init_read_msg_block();
+		ddrphy_qb_read_mr(&mr[i]);
 
 		/* If NumPStates more than 2, resumePsloop "DMA reload" prepare resume, no action */
 		/* config PIE pstate reg */
-		ddrphy_cfg_set(fsp_msg->fsp_phy_pie_cfg,
-			       fsp_msg->fsp_phy_pie_cfg_num);
+		ret = ddrphy_cfg_set(fsp_msg->fsp_phy_pie_cfg,
+				     fsp_msg->fsp_phy_pie_cfg_num);
+		if (ret)
+			return ret;
 		/* If NumPStates more than 2, "DMA reload" prepare end, prepare Xlat Table for this PState */
 		/* action is included in end of fsp_phy_pie_cfg */
 		fsp_msg++;
 	}
 
 	/* Load PHY Init Engine Image */
-	ddrphy_cfg_set(dtiming->ddrphy_pie, dtiming->ddrphy_pie_num);
+	ret = ddrphy_cfg_set(dtiming->ddrphy_pie, dtiming->ddrphy_pie_num);
+	if (ret)
+		return ret;
 
 	dwc_ddrphy_apb_wr(0xd0000, 0x1); /* CSR bus: MCU/PIE/DMA++,TDR/APB-- */
 
+	ddr_train_log_summary();
+
 	return 0;
 }
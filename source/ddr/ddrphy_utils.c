@@ -5,6 +5,9 @@
 
 #include "ddr.h"
 #include "asm/arch/clock.h"
+#include "time.h"
+#include "debug.h"
+#include <errno.h>
 
 static inline void poll_pmu_message_ready(void)
 {
@@ -64,8 +67,9 @@ static inline void decode_streaming_message(void)
 	u32 i = 0;
 
 	string_index = get_stream_message();
+	ddr_train_log(DDR_TRAIN_LOG_STRING, string_index);
 	while (i < (string_index & 0xffff)) {
-		get_stream_message();
+		ddr_train_log(DDR_TRAIN_LOG_ARG, get_stream_message());
 		i++;
 	}
 }
@@ -76,6 +80,7 @@ int wait_ddrphy_training_complete(void)
 
 	while (1) {
 		mail = get_mail();
+		ddr_train_log(DDR_TRAIN_LOG_MAJOR, mail);
 		switch (mail) {
 		case 0x08:
 			decode_streaming_message();
@@ -92,92 +97,261 @@ int wait_ddrphy_training_complete(void)
 	}
 }
 
-void ddrphy_init_set_dfi_clk(unsigned int drate)
+/* Take the PMU out of reset and stall, the firmware starts running */
+static const u16 ddrphy_pmu_run_seq[] = {
+	SEQ_PHY_WR(0xd0000, 0x1), /* CSR bus: MCU/PIE/DMA++,TDR/APB-- */
+	SEQ_PHY_WR(0xd0099, 0x9),
+	SEQ_PHY_WR(0xd0099, 0x1),
+	SEQ_PHY_WR(0xd0099, 0x0),
+};
+
+int ddrphy_pmu_run(void)
+{
+	int ret;
+
+	ret = ddr_seq_exec(ddrphy_pmu_run_seq);
+	if (ret)
+		return ret;
+
+	/* Wait for the firmware to complete */
+	return wait_ddrphy_training_complete();
+}
+
+/* SequenceCtrl steps run for a FSP */
+u16 ddrphy_train_steps(struct dram_fsp_msg *fsp_msg)
+{
+	struct ddrphy_cfg_param *cfg = fsp_msg->fsp_phy_msgh_cfg;
+	u32 i, steps = fsp_msg->train_steps;
+
+	for (i = 0; !steps && cfg && i < fsp_msg->fsp_phy_msgh_cfg_num; i++) {
+		if (cfg[i].reg == DMEM_OFFSET_ADDR + DDRPHY_MSB_SEQ_CTRL)
+			steps = cfg[i].val;
+	}
+
+	return steps & DDRPHY_TRAIN_STEPS;
+}
+
+/* Training steps and the steps whose results they rely on */
+static const struct {
+	u16 step;
+	u16 deps;
+} ddrphy_train_deps[] = {
+	{ DDRPHY_STEP_RDDQS1D,	DDRPHY_STEP_RXEN },
+	{ DDRPHY_STEP_WRDQ1D,	DDRPHY_STEP_WRLVL | DDRPHY_STEP_RDDQS1D },
+	{ DDRPHY_STEP_RDDESKEW,	DDRPHY_STEP_RXEN },
+	{ DDRPHY_STEP_MXRDLAT,	DDRPHY_STEP_RXEN },
+};
+
+/* Check that every training step of a FSP runs along with the steps it relies on */
+int ddrphy_train_steps_check(struct dram_fsp_msg *fsp_msg)
+{
+	u16 steps = ddrphy_train_steps(fsp_msg);
+	u32 i;
+
+	/* every step relies on the DRAM device initialization */
+	if (steps && !(steps & DDRPHY_STEP_DEVINIT)) {
+		printf("** DDR OEI: %u MT/s steps 0x%x lack DevInit **\n", fsp_msg->drate, steps);
+		return -EINVAL;
+	}
+
+	for (i = 0; i < ARRAY_SIZE(ddrphy_train_deps); i++) {
+		if ((steps & ddrphy_train_deps[i].step) &&
+		    (steps & ddrphy_train_deps[i].deps) != ddrphy_train_deps[i].deps) {
+			printf("** DDR OEI: %u MT/s steps 0x%x, 0x%x needs 0x%x **\n", fsp_msg->drate,
+			       steps, ddrphy_train_deps[i].step, ddrphy_train_deps[i].deps);
+			return -EINVAL;
+		}
+	}
+
+	return 0;
+}
+
+/* Highest drate clocked from the CCM in bypass, SYS_PLL_PFD2 undivided */
+#define DDRPHY_BYPASS_MAX_DRATE	625
+
+/**
+ * DRAM PLL rate for drate, 0 for the drates clocked from the CCM in bypass.
+ * The listed drates keep their historical rates, others run at drate / 8,
+ * the dividers are computed by fracpll_start().
+ */
+static u32 ddrphy_dfi_pll_rate(unsigned int drate)
 {
+	if (drate <= DDRPHY_BYPASS_MAX_DRATE)
+		return 0;
+
 	switch (drate) {
 	case 6400:
-		dram_pll_init(MHZ(800));
-		dram_disable_bypass();
-		break;
+		return MHZ(800);
 	case 4800:
-		dram_pll_init(MHZ(600));
-		dram_disable_bypass();
-		break;
+		return MHZ(600);
 	case 4266: /* Assume 4266.(6) */
-		dram_pll_init(533333333);
-		dram_disable_bypass();
-		break;
+		return 533333333;
 	case 3733: /* Assume 3733.(3) */
-		dram_pll_init(466666666);
-		dram_disable_bypass();
-		break;
+		return 466666666;
 	case 3200:
-		dram_pll_init(MHZ(400));
-		dram_disable_bypass();
-		break;
+		return MHZ(400);
 	case 2133: /* Assume 2133.(3) */
-		dram_pll_init(266666666);
-		dram_disable_bypass();
-		break;
+		return 266666666;
 	case 2400:
-		dram_pll_init(MHZ(300));
-		dram_disable_bypass();
-		break;
+		return MHZ(300);
 	case 1866:
-		dram_pll_init(MHZ(233));
-		dram_disable_bypass();
-		break;
+		return MHZ(233);
 	case 1600:
-		dram_pll_init(MHZ(200));
-		dram_disable_bypass();
-		break;
+		return MHZ(200);
 	case 1200:
-		dram_pll_init(MHZ(150));
-		dram_disable_bypass();
-		break;
+		return MHZ(150);
 	case 1066:
-		dram_pll_init(MHZ(133));
-		dram_disable_bypass();
-		break;
+		return MHZ(133);
 	case 933:
-		dram_pll_init(MHZ(116));
-		dram_disable_bypass();
-		break;
+		return MHZ(116);
 	case 800:
-		dram_pll_init(MHZ(100));
-		dram_disable_bypass();
-		break;
+		return MHZ(100);
 	case 667:
-		dram_pll_init(MHZ(83));
-		dram_disable_bypass();
-		break;
-	case 625:
-		dram_enable_bypass(MHZ(625));
-		break;
-	case 400:
-		dram_enable_bypass(MHZ(400));
-		break;
-	case 333:
-		dram_enable_bypass(MHZ(333));
-		break;
-	case 200:
-		dram_enable_bypass(MHZ(200));
-		break;
-	case 100:
-		dram_enable_bypass(MHZ(100));
-		break;
+		return MHZ(83);
 	default:
-		return;
+		return drate * (MHZ(1) / 8);
 	}
 }
 
-void ddrphy_cfg_set(struct ddrphy_cfg_param *cfg, unsigned int num)
+/* Report the time the DRAM PLL took to lock at rate */
+static void ddrphy_dfi_pll_report(void)
+{
+#ifdef DEBUG
+	u32 rate, lock_us;
+
+	lock_us = fracpll_lock_time(DRAM_PLL_CLK, &rate);
+	printf("** DDR OEI: DRAM PLL %u Hz locked in %u us **\n", rate, lock_us);
+#endif
+}
+
+int ddrphy_init_set_dfi_clk(unsigned int drate)
+{
+	u32 rate = ddrphy_dfi_pll_rate(drate);
+	int ret;
+
+	if (!rate)
+		return dram_enable_bypass(MHZ(drate));
+
+	ret = dram_pll_init(rate);
+	if (ret)
+		return ret;
+
+	ddrphy_dfi_pll_report();
+	dram_disable_bypass();
+
+	return 0;
+}
+
+/* Max number of halfwords copied per firmware load step while the PLL locks */
+#define DDR_FW_XFER_CHUNK	64
+
+static inline bool ddr_deadline_reached(u32 deadline_us)
+{
+	return (int)(timer_get_us() - deadline_us) >= 0;
+}
+
+static void ddr_wait_until(u32 deadline_us)
+{
+	while (!ddr_deadline_reached(deadline_us))
+		;
+}
+
+/**
+ * Start switching the DFI clock to drate without waiting for the DRAM PLL
+ * lock, the DRAM clock root runs from the CCM until ddr_bringup_clk_ready().
+ */
+int ddrphy_dfi_clk_start(struct ddr_bringup *bu, unsigned int drate)
+{
+	u32 rate = ddrphy_dfi_pll_rate(drate);
+	int ret;
+
+	bu->pll_pending = false;
+	if (!rate)
+		return dram_enable_bypass(MHZ(drate));
+
+	/**
+	 * park the DRAM clock root on the CCM while the PLL relocks, the
+	 * bypass path also used for the lower drates keeps the PHY clocked
+	 * for the APB accesses of the common config and the IMEM load
+	 */
+	ret = dram_enable_bypass(MHZ(400));
+	if (ret)
+		return ret;
+
+	ret = fracpll_start(DRAM_PLL_CLK, rate);
+	if (ret)
+		return ret;
+
+	bu->lock_us = timer_get_us();
+#ifndef CONFIG_IMX95_EMU
+	bu->lock_us += FRACPLL_LOCK_US;
+#endif
+	bu->pll_pending = true;
+
+	return 0;
+}
+
+/* Wait for the end of the post-reset settle window before any PHY APB access */
+void ddr_bringup_phy_ready(struct ddr_bringup *bu)
+{
+	ddr_wait_until(bu->settle_us);
+}
+
+/**
+ * Finish the DFI clock switch started by ddrphy_dfi_clk_start(). The
+ * firmware load xfer, if any, is advanced on the CPU until the PLL locks
+ * or the lock deadline and its eDMA transfer is drained before the DRAM
+ * clock root switches to the PLL.
+ */
+int ddr_bringup_clk_ready(struct ddr_bringup *bu, struct ddr_fw_xfer *xfer)
+{
+	int ret;
+
+	if (!bu->pll_pending)
+		return 0;
+
+	while (xfer && !ddr_deadline_reached(bu->lock_us) &&
+	       !fracpll_locked(DRAM_PLL_CLK) &&
+	       ddr_fw_xfer_step(xfer, DDR_FW_XFER_CHUNK))
+		;
+
+	if (xfer && xfer->dma)
+		ddr_fw_xfer_wait(xfer);
+
+	bu->pll_pending = false;
+
+	/* polls the lock up to the deadline */
+	ret = fracpll_lock(DRAM_PLL_CLK);
+	if (ret)
+		return ret;
+
+	ddrphy_dfi_pll_report();
+
+	dram_disable_bypass();
+
+	return 0;
+}
+
+#if defined(CONFIG_DDRPHY_BURST)
+/**
+ * Run-encoded PHY tables are BURST/FILL register sequences (see DDR_SEQ_*
+ * in ddr.h), num is the table length in halfwords.
+ */
+int ddrphy_cfg_set(ddrphy_cfg_tbl *cfg, unsigned int num)
+{
+	return ddr_seq_run(cfg, num);
+}
+#else
+int ddrphy_cfg_set(ddrphy_cfg_tbl *cfg, unsigned int num)
 {
 	unsigned int i;
 
 	for (i = 0; i < num; i++, cfg++)
 		dwc_ddrphy_apb_wr(cfg->reg, cfg->val);
+
+	return 0;
 }
+#endif
 
 __attribute__ ((weak)) void ddrphy_init_read_msg_block(void)
 {
@@ -5,66 +5,332 @@
 #include <asm/io.h>
 #include <errno.h>
 #include "ddr.h"
+#include "edma.h"
 
 static char _end[0] __attribute__((section(".__end")));
 
-#if !defined(CONFIG_DDR_QBOOT)
-static void check_cfg_id(struct dram_fsp_msg *fsp_msg, u32 reg, u32 *cfg_id, u16 *val)
+struct ddr_fw_header {
+	u32 imem_size;
+	u32 dmem_size;
+};
+
+/**
+ * Compressed firmware container, packed by scripts/ddr_fw_pack.py.
+ *
+ * The IMEM and DMEM images are each stored as an LZ stream of halfwords:
+ * a flags halfword announces the type of the next 16 items, LSB first.
+ * A clear bit is a literal halfword, a set bit a match halfword copying
+ * ([15:8] + 2) halfwords from ([7:0] + 1) halfwords back, so that the
+ * decoder only needs a DDR_FW_LZ_WIN halfwords history on the stack.
+ * The stream sizes are in bytes.
+ */
+#define DDR_FW_LZ_MAGIC		0x5a4c5744	/* "DWLZ" */
+#define DDR_FW_LZ_WIN		256
+
+struct ddr_fw_lz_header {
+	u32 magic;
+	u32 imem_size;
+	u32 dmem_size;
+	u32 imem_lz_size;
+	u32 dmem_lz_size;
+};
+
+/**
+ * Locate the IMEM or DMEM image appended after _end, fw_num is set to
+ * the image size in halfwords. Returns 0 for a plain image, 1 for an LZ
+ * stream.
+ */
+static int ddr_fw_locate(enum mem_type type, unsigned long *fw, u32 *fw_num)
+{
+	struct ddr_fw_header *header = (struct ddr_fw_header *)((void *)&_end);
+	struct ddr_fw_lz_header *lz = (struct ddr_fw_lz_header *)((void *)&_end);
+
+	if (lz->magic == DDR_FW_LZ_MAGIC) {
+		*fw = (unsigned long)&_end + sizeof(*lz);
+		if (type == IMEM) {
+			*fw_num = lz->imem_size / sizeof(u16);
+		} else {
+			*fw    += lz->imem_lz_size;
+			*fw_num = lz->dmem_size / sizeof(u16);
+		}
+		return 1;
+	}
+
+	*fw = (unsigned long)&_end + sizeof(*header);
+	if (type == IMEM) {
+		*fw_num = header->imem_size / sizeof(u16);
+	} else {
+		*fw    += header->imem_size;
+		*fw_num = header->dmem_size / sizeof(u16);
+	}
+	return 0;
+}
+
+/* Decode an LZ stream straight into PHY SRAM, skipping the first skip halfwords */
+static void ddr_fw_lz_unpack(const u16 *src, unsigned long dst, u32 skip, u32 num)
+{
+	u16 win[DDR_FW_LZ_WIN];
+	u32 i = 0, flags = 1, len, dist;
+	u16 tok, val;
+
+	while (i < num) {
+		if (flags == 1)
+			flags = *src++ | 0x10000;
+
+		if (flags & 1) {
+			tok  = *src++;
+			len  = (tok >> 8) + 2;
+			dist = (tok & 0xff) + 1;
+		} else {
+			len  = 1;
+			dist = 0;
+		}
+		flags >>= 1;
+
+		for ( ; len && i < num; len--, i++) {
+			val = dist ? win[(i - dist) % DDR_FW_LZ_WIN] : *src++;
+			win[i % DDR_FW_LZ_WIN] = val;
+			if (i >= skip)
+				writew(val, dst + ddrphy_addr_remap(i));
+		}
+	}
+}
+
+#if defined(CONFIG_DDRPHY_EDMA)
+/* Start copying num halfwords with eDMA, src_off/dst_off are the address strides */
+static int ddr_dma_start(unsigned long src, int src_off, unsigned long dst, int dst_off, u32 num)
 {
-	struct ddrphy_cfg_param *cfg = fsp_msg->fsp_phy_msgh_cfg;
-	u32 cfg_num = fsp_msg->fsp_phy_msgh_cfg_num;
-	u32 id = (*cfg_id);
+	int ret;
 
-	/**
-	 * Point the config ID to the position where the current register
-	 * (reg) is less or equal to the config register (cfg[id].reg)
-	 * The assumption is that the registers in "fsp_phy_msgh_cfg" are
-	 * in ascending order
-	 */
-	while (id < cfg_num && ((cfg[id].reg & 0xff000) != DMEM_OFFSET_ADDR || reg > cfg[id].reg))
-		id++;
+	ret = edma_set(EDMA2_BASE_ADDR, src, 2, src_off, dst, 2, dst_off, num * sizeof(u16), 1);
+	if (ret == 0)
+		edma_start(EDMA2_BASE_ADDR);
+	else
+		edma_clr(EDMA2_BASE_ADDR);
 
-	*val = (id == cfg_num || reg < cfg[id].reg ? 0 : cfg[id].val);
-	*cfg_id = id;
+	return ret;
+}
+
+/* Start copying num halfwords with eDMA: 2-byte source stride, 4-byte PHY APB stride */
+static int ddr_fw_dma_start(unsigned long src, unsigned long dst, u32 num)
+{
+	return ddr_dma_start(src, 2, dst, 4, num);
+}
+
+static int ddr_fw_dma_wait(void)
+{
+	int ret;
+
+	ret = edma_wait(EDMA2_BASE_ADDR);
+	edma_clr(EDMA2_BASE_ADDR);
+
+	return ret;
+}
+
+static int ddr_fw_dma(unsigned long src, unsigned long dst, u32 num)
+{
+	int ret;
+
+	ret = ddr_fw_dma_start(src, dst, num);
+	if (ret == 0)
+		ret = ddr_fw_dma_wait();
+
+	return ret;
 }
 #endif
 
-struct ddr_fw_header {
-	u32 imem_size;
-	u32 dmem_size;
-};
+/* Write num halfwords from src to PHY SRAM, dst is the APB address of the first one */
+static void ddr_fw_write(unsigned long src, unsigned long dst, u32 num)
+{
+	u32 i;
+
+#if defined(CONFIG_DDRPHY_EDMA)
+	/* fall back to the CPU copy if the eDMA transfer fails */
+	if (num == 0 || ddr_fw_dma(src, dst, num) == 0)
+		return;
+#endif
+	for (i = 0; i < num; i++) {
+		writew(readw(src), dst + ddrphy_addr_remap(i));
+		src += sizeof(u16);
+	}
+}
+
+/* Copy an IMEM/DMEM image from its first halfword skip on into PHY SRAM */
+static void ddr_fw_copy(enum mem_type type, unsigned long pr_to32, u32 skip)
+{
+	unsigned long fw, dst = IP2APB_DDRPHY_IPS_BASE_ADDR(0) + ddrphy_addr_remap(pr_to32);
+	u32 fw_num;
+
+	if (ddr_fw_locate(type, &fw, &fw_num)) {
+		ddr_fw_lz_unpack((const u16 *)fw, dst, skip, fw_num);
+		return;
+	}
+
+	if (skip < fw_num)
+		ddr_fw_write(fw + skip * sizeof(u16), dst + ddrphy_addr_remap(skip), fw_num - skip);
+}
+
+/**
+ * Start loading a whole IMEM/DMEM image in the background of other work:
+ * the eDMA transfer is kicked off when enabled, the CPU copy is otherwise
+ * advanced by ddr_fw_xfer_step(). LZ images are decoded right away as the
+ * decoder history lives on its stack.
+ */
+void ddr_fw_xfer_start(struct ddr_fw_xfer *xfer, enum mem_type type)
+{
+	unsigned long pr_to32 = (type == IMEM ? IMEM_OFFSET_ADDR : DMEM_OFFSET_ADDR);
+
+	xfer->dst = IP2APB_DDRPHY_IPS_BASE_ADDR(0) + ddrphy_addr_remap(pr_to32);
+	xfer->i = 0;
+	xfer->dma = false;
+
+	if (ddr_fw_locate(type, &xfer->fw, &xfer->num)) {
+		ddr_fw_lz_unpack((const u16 *)xfer->fw, xfer->dst, 0, xfer->num);
+		xfer->i = xfer->num;
+		return;
+	}
+#if defined(CONFIG_DDRPHY_EDMA)
+	if (xfer->num && ddr_fw_dma_start(xfer->fw, xfer->dst, xfer->num) == 0)
+		xfer->dma = true;
+#endif
+}
+
+/* Copy up to num more halfwords with the CPU, returns the halfwords left */
+u32 ddr_fw_xfer_step(struct ddr_fw_xfer *xfer, u32 num)
+{
+	unsigned long fw = xfer->fw + xfer->i * sizeof(u16);
+
+	if (xfer->dma)
+		return xfer->num - xfer->i;
+
+	for ( ; num && xfer->i < xfer->num; num--, xfer->i++) {
+		writew(readw(fw), xfer->dst + ddrphy_addr_remap(xfer->i));
+		fw += sizeof(u16);
+	}
+
+	return xfer->num - xfer->i;
+}
+
+/* Complete a firmware load, the image is entirely in PHY SRAM on return */
+void ddr_fw_xfer_wait(struct ddr_fw_xfer *xfer)
+{
+#if defined(CONFIG_DDRPHY_EDMA)
+	if (xfer->dma) {
+		xfer->dma = false;
+		/* fall back to the CPU copy if the eDMA transfer fails */
+		if (ddr_fw_dma_wait() == 0)
+			xfer->i = xfer->num;
+	}
+#endif
+	ddr_fw_xfer_step(xfer, xfer->num);
+}
+
+/**
+ * Start moving num halfwords between buf and the PHY SRAM at APB address
+ * addr, to the PHY when to_phy is set. With eDMA the copy runs in the
+ * background until ddrphy_sram_xfer_wait(), the CPU does it there otherwise.
+ */
+void ddrphy_sram_xfer_start(struct ddrphy_sram_xfer *xfer, u16 *buf, u32 addr, u32 num,
+			    bool to_phy)
+{
+#if defined(CONFIG_DDRPHY_EDMA)
+	unsigned long phy = IP2APB_DDRPHY_IPS_BASE_ADDR(0) + ddrphy_addr_remap(addr);
+	int ret;
+#endif
+
+	xfer->buf = buf;
+	xfer->addr = addr;
+	xfer->num = num;
+	xfer->to_phy = to_phy;
+	xfer->dma = false;
+
+#if defined(CONFIG_DDRPHY_EDMA)
+	if (num == 0)
+		return;
+
+	if (to_phy)
+		ret = ddr_dma_start((unsigned long)buf, 2, phy, 4, num);
+	else
+		ret = ddr_dma_start(phy, 4, (unsigned long)buf, 2, num);
+
+	xfer->dma = (ret == 0);
+#endif
+}
+
+/* Complete a PHY SRAM block copy */
+void ddrphy_sram_xfer_wait(struct ddrphy_sram_xfer *xfer)
+{
+	u32 i;
+
+#if defined(CONFIG_DDRPHY_EDMA)
+	if (xfer->dma) {
+		xfer->dma = false;
+		/* fall back to the CPU copy if the eDMA transfer fails */
+		if (ddr_fw_dma_wait() == 0)
+			return;
+	}
+#endif
+	if (xfer->to_phy) {
+		for (i = 0; i < xfer->num; i++)
+			dwc_ddrphy_apb_wr(xfer->addr + i, xfer->buf[i]);
+	} else {
+		for (i = 0; i < xfer->num; i++)
+			xfer->buf[i] = dwc_ddrphy_apb_rd(xfer->addr + i);
+	}
+}
 
 u32 ddr_get_qb_state_addr(void)
 {
 	struct ddr_fw_header *header = (struct ddr_fw_header *)((void *)&_end);
-	u32 header_size = sizeof(struct ddr_fw_header);
-	u32 fw;
+	struct ddr_fw_lz_header *lz = (struct ddr_fw_lz_header *)((void *)&_end);
 
-	fw = (u32)&_end + header_size + header->imem_size + header->dmem_size;
+	if (lz->magic == DDR_FW_LZ_MAGIC)
+		return (u32)&_end + sizeof(*lz) + lz->imem_lz_size + lz->dmem_lz_size;
 
-	return fw;
+	return (u32)&_end + sizeof(*header) + header->imem_size + header->dmem_size;
+}
+
+/**
+ * Merge the FSP message block overrides into mb, a DDRPHY_QB_MSB_SIZE
+ * halfwords image of the DMEM start. Halfwords not overridden are 0.
+ */
+void ddrphy_prepare_mb(u16 *mb, struct dram_fsp_msg *fsp_msg)
+{
+	struct ddrphy_cfg_param *cfg;
+	u32 i, idx;
+
+	for (i = 0; i < DDRPHY_QB_MSB_SIZE; i++)
+		mb[i] = 0;
+
+	if (fsp_msg == NULL || fsp_msg->fsp_phy_msgh_cfg == NULL)
+		return;
+
+	cfg = fsp_msg->fsp_phy_msgh_cfg;
+	for (i = 0; i < fsp_msg->fsp_phy_msgh_cfg_num; i++, cfg++) {
+		if ((cfg->reg & 0xff000) != DMEM_OFFSET_ADDR)
+			continue;
+		idx = (cfg->reg & 0xfff);
+		if (idx >= DDRPHY_QB_MSB_SIZE)
+			continue;
+		mb[idx] = cfg->val;
+	}
+
+	mb[DDRPHY_MSB_SEQ_CTRL] = ddrphy_train_steps(fsp_msg);
 }
 
 void ddr_load_train_firmware(struct dram_fsp_msg *fsp_msg, enum mem_type type)
 {
-	u16 val;
-	u32 fw_num, i;
-	unsigned long fw, pr_to32;
-	struct ddr_fw_header *header = (struct ddr_fw_header *)((void *)&_end);
-	u32 header_size = sizeof(struct ddr_fw_header);
-#if !defined(CONFIG_DDR_QBOOT)
-	u32 cfg_id;
+	unsigned long pr_to32;
+	u32 i = 0;
+#if defined(DDR_TRAIN_FLOW)
+	u16 *mb;
 #endif
 
 	switch (type) {
 	case IMEM:
-		fw      = (unsigned long)&_end + header_size;
-		fw_num  = header->imem_size / sizeof(val);
 		pr_to32 = IMEM_OFFSET_ADDR;
 		break;
 	case DMEM:
-		fw      = (unsigned long)&_end + header_size + header->imem_size;
-		fw_num  = header->dmem_size / sizeof(val);
 		pr_to32 = DMEM_OFFSET_ADDR;
 		break;
 	default:
@@ -72,54 +338,32 @@ void ddr_load_train_firmware(struct dram_fsp_msg *fsp_msg, enum mem_type type)
 		return;
 	}
 
-	i = 0;
-#if !defined(CONFIG_DDR_QBOOT)
+#if defined(DDR_TRAIN_FLOW)
 	if (type == DMEM && fsp_msg != NULL && fsp_msg->fsp_phy_msgh_cfg != NULL) {
-		cfg_id = 0;
-		for ( ; i < DDRPHY_QB_MSB_SIZE; i++, pr_to32++) {
-			check_cfg_id(fsp_msg, pr_to32, &cfg_id, &val);
-			writew(val, IP2APB_DDRPHY_IPS_BASE_ADDR(0) + ddrphy_addr_remap(pr_to32));
-			fw += sizeof(val);
-		}
+		/* QB state memory is free until ddrphy_qb_save() */
+		mb = (u16 *)QB_STATE_MEM;
+		ddrphy_prepare_mb(mb, fsp_msg);
+		i = DDRPHY_QB_MSB_SIZE;
+		ddr_fw_write((unsigned long)mb,
+			     IP2APB_DDRPHY_IPS_BASE_ADDR(0) + ddrphy_addr_remap(pr_to32), i);
 	}
 #endif
-	for ( ; i < fw_num; i++, pr_to32++) {
-		val = readw(fw);
-		writew(val, IP2APB_DDRPHY_IPS_BASE_ADDR(0) + ddrphy_addr_remap(pr_to32));
-		fw += sizeof(val);
-	}
+	ddr_fw_copy(type, pr_to32, i);
 }
 
-#if defined(CONFIG_DDR_QBOOT)
-void ddr_load_DMEM(u16 *msg_blk, ddrphy_qb_state *qb_state)
+#if defined(DDR_QB_FLOW)
+/* Load the QuickBoot DMEM, csr is NULL when the CSR area is already written */
+void ddr_load_DMEM(u16 *msg_blk, const u16 *csr)
 {
-	struct ddr_fw_header *header = (struct ddr_fw_header *)((void *)&_end);
-	u32 header_size = sizeof(struct ddr_fw_header);
-	unsigned long fw, pr_to32;
-	u32 fw_num, i, j;
-	u16 val;
-
-	fw      = (unsigned long)&_end + header_size + header->imem_size;
-	fw_num  = header->dmem_size / sizeof(val);
-	pr_to32 = DMEM_OFFSET_ADDR;
-
-	for (i = 0; i < DDRPHY_QB_MSB_SIZE; i++, pr_to32++) {
-		val = msg_blk[i];
-		writew(val, IP2APB_DDRPHY_IPS_BASE_ADDR(0) + ddrphy_addr_remap(pr_to32));
-		fw += sizeof(val);
-	}
+	unsigned long dst = IP2APB_DDRPHY_IPS_BASE_ADDR(0) + ddrphy_addr_remap(DMEM_OFFSET_ADDR);
+
+	ddr_fw_write((unsigned long)msg_blk, dst, DDRPHY_QB_MSB_SIZE);
 
 	/* save CSRs to address starting with 0x58200 */
-	for (j = 0; j < DDRPHY_QB_CSR_SIZE; j++, i++, pr_to32++) {
-		val = qb_state->csr[j];
-		writew(val, IP2APB_DDRPHY_IPS_BASE_ADDR(0) + ddrphy_addr_remap(pr_to32));
-		fw += sizeof(val);
-	}
+	if (csr)
+		ddr_fw_write((unsigned long)csr, dst + ddrphy_addr_remap(DDRPHY_QB_MSB_SIZE),
+			     DDRPHY_QB_CSR_SIZE);
 
-	for ( ; i < fw_num; i++, pr_to32++) {
-		val = readw(fw);
-		writew(val, IP2APB_DDRPHY_IPS_BASE_ADDR(0) + ddrphy_addr_remap(pr_to32));
-		fw += sizeof(val);
-	}
+	ddr_fw_copy(DMEM, DMEM_OFFSET_ADDR, DDRPHY_QB_MSB_SIZE + DDRPHY_QB_CSR_SIZE);
 }
 #endif
@@ -40,15 +40,32 @@ uint32_t __attribute__((section(".entry"))) oei_entry(void)
 	int ret;
 #ifdef DDR_MEM_TEST
 	int fail = 0;
+#endif
+#if defined(CONFIG_CPU_BOOST)
+	u32 cpu_clk;
+	int boost;
+#endif
+#ifdef DEBUG
+	u32 ts;
 #endif
 	if (!timer_is_enabled())
 		timer_enable();
+#ifdef DEBUG
+	ts = timer_get_us();
+#endif
+#if defined(CONFIG_CPU_BOOST)
+	boost = clock_cpu_boost(&cpu_clk);
+#endif
+	/* after any CPU clock change, calibrated along the boot, not waited for */
+	timer_calibrate();
 
 	clock_init();
 	pinmux_config();
 	lpuart32_serial_init();
 
-#ifdef	CONFIG_DDR_QBOOT
+#if defined(CONFIG_DDR_QBOOT_AUTO)
+	printf("\n\n** DDR OEI: QuickBoot or Training, commit: %08x **\n", OEI_COMMIT);
+#elif defined(CONFIG_DDR_QBOOT)
 	printf("\n\n** DDR OEI: QuickBoot, commit: %08x **\n", OEI_COMMIT);
 #else
 	printf("\n\n** DDR OEI: Training, commit: %08x **\n", OEI_COMMIT);
@@ -69,7 +86,15 @@ uint32_t __attribute__((section(".entry"))) oei_entry(void)
 			printf("** DDR OEI: memtest pass! **\n");
 	}
 #endif
-	printf("** DDR OEI: done, err=%d **\n", ret);
+	printf("** DDR OEI: done, err=%d, in %u us **\n", ret, timer_get_us() - ts);
+
+#if defined(CONFIG_CPU_BOOST)
+	/* back to the ROM CPU clock, the cycle counter is calibrated again */
+	if (!boost) {
+		clock_cpu_restore(cpu_clk);
+		timer_calibrate();
+	}
+#endif
 
 	return (ret == 0 ? OEI_SUCCESS_FREE_MEM : OEI_FAIL);
 }
@@ -14,9 +14,24 @@ extern int tcm_init(void);
 uint32_t __attribute__((section(".entry"))) oei_entry(void)
 {
 	int ret = 0;
+#if defined(CONFIG_CPU_BOOST)
+	u32 cpu_clk;
+	int boost;
+#endif
+#ifdef DEBUG
+	u32 ts;
+#endif
 
 	if (!timer_is_enabled())
 		timer_enable();
+#ifdef DEBUG
+	ts = timer_get_us();
+#endif
+#if defined(CONFIG_CPU_BOOST)
+	boost = clock_cpu_boost(&cpu_clk);
+#endif
+	/* after any CPU clock change, calibrated along the boot, not waited for */
+	timer_calibrate();
 
 	clock_init();
 	pinmux_config();
@@ -24,7 +39,15 @@ uint32_t __attribute__((section(".entry"))) oei_entry(void)
 
 	printf("\n\n** TCM OEI: start **\n");
 	ret = tcm_init();
-	printf("\n\n** TCM OEI: end ret = 0x%x **\n", ret);
+	printf("\n\n** TCM OEI: end ret = 0x%x, in %u us **\n", ret, timer_get_us() - ts);
+
+#if defined(CONFIG_CPU_BOOST)
+	/* back to the ROM CPU clock, the cycle counter is calibrated again */
+	if (!boost) {
+		clock_cpu_restore(cpu_clk);
+		timer_calibrate();
+	}
+#endif
 
 	return (ret == 0 ? OEI_SUCCESS_FREE_MEM : OEI_FAIL);
 }
@@ -4,6 +4,77 @@
  */
 #include "crc.h"
 
+#if defined(CA55) && defined(__ARM_FEATURE_CRC32)
+/**
+ * ARMv8 CRC32 instructions, same reflected polynomial 0xEDB88320: bytes
+ * up to an 8 bytes boundary, then doublewords
+ */
+u32 crc32_update(u32 crc, const void* addr, u32 len)
+{
+	const u8 *chr = (const u8*)addr;
+	const u64 *dw;
+
+	crc = ~crc;
+
+	for (; len && ((ulong)chr & 7); len--, chr++)
+		__asm__("crc32b %w0, %w0, %w1" : "+r" (crc) : "r" ((u32)*chr));
+
+	for (dw = (const void *)chr; len >= 8; len -= 8, dw++)
+		__asm__("crc32x %w0, %w0, %x1" : "+r" (crc) : "r" (*dw));
+
+	chr = (const void *)dw;
+	if (len >= 4) {
+		__asm__("crc32w %w0, %w0, %w1" : "+r" (crc) : "r" (*(const u32 *)(const void *)chr));
+		chr += 4;
+		len -= 4;
+	}
+
+	for (; len; len--, chr++)
+		__asm__("crc32b %w0, %w0, %w1" : "+r" (crc) : "r" ((u32)*chr));
+
+	return ~crc;
+}
+#elif defined(CONFIG_CRC32_SLICE)
+#include "crc32_table.h"
+
+/**
+ * Slicing-by-4/8 CRC algorithm, tables generated by scripts/crc32_table.py:
+ * bytes up to a word boundary, then CONFIG_CRC32_SLICE bytes per step
+ */
+u32 crc32_update(u32 crc, const void* addr, u32 len)
+{
+	const u8 *chr = (const u8*)addr;
+	const u32 *word;
+	u32 lo;
+#if CONFIG_CRC32_SLICE == 8
+	u32 hi;
+#endif
+
+	crc = ~crc;
+
+	for (; len && ((unsigned long)chr & 3); len--, chr++)
+		crc = crc32_table[0][(crc ^ *chr) & 0xff] ^ (crc >> 8);
+
+	for (word = (const void *)chr; len >= CONFIG_CRC32_SLICE; len -= CONFIG_CRC32_SLICE) {
+		lo = crc ^ *word++;
+#if CONFIG_CRC32_SLICE == 8
+		hi = *word++;
+		crc = crc32_table[7][lo & 0xff] ^ crc32_table[6][(lo >> 8) & 0xff] ^
+		      crc32_table[5][(lo >> 16) & 0xff] ^ crc32_table[4][lo >> 24] ^
+		      crc32_table[3][hi & 0xff] ^ crc32_table[2][(hi >> 8) & 0xff] ^
+		      crc32_table[1][(hi >> 16) & 0xff] ^ crc32_table[0][hi >> 24];
+#else
+		crc = crc32_table[3][lo & 0xff] ^ crc32_table[2][(lo >> 8) & 0xff] ^
+		      crc32_table[1][(lo >> 16) & 0xff] ^ crc32_table[0][lo >> 24];
+#endif
+	}
+
+	for (chr = (const void *)word; len; len--, chr++)
+		crc = crc32_table[0][(crc ^ *chr) & 0xff] ^ (crc >> 8);
+
+	return ~crc;
+}
+#else
 /** Polynomial: 0xEDB88320 */
 static u32 const p_table[] =
 {
@@ -16,11 +87,13 @@ static u32 const p_table[] =
 /**
  * Implement half-byte CRC algorithm
  */
-u32 crc32(const void* addr, u32 len)
+u32 crc32_update(u32 crc, const void* addr, u32 len)
 {
-	u32 crc = ~0x00, idx, i, val;
+	u32 idx, i, val;
 	const u8 *chr = (const u8*)addr;
 
+	crc = ~crc;
+
 	for (i = 0; i < len; i++, chr++)
 	{
 		val = (u32)(*chr);
@@ -33,3 +106,9 @@ u32 crc32(const void* addr, u32 len)
 
 	return ~crc;
 }
+#endif
+
+u32 crc32(const void* addr, u32 len)
+{
+	return crc32_update(0, addr, len);
+}
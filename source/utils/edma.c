@@ -0,0 +1,291 @@
+// SPDX-License-Identifier: GPL-2.0+
+/*
+ * Copyright 2023-2024 NXP
+ */
+#include "edma.h"
+
+/* WAKEUP.EDMA5 - Register Layout Typedef */
+typedef struct {
+    volatile uint32_t MP_CSR;                   /**< Management Page Control Register, offset: 0x0 */
+    volatile uint32_t MP_ES;                    /**< Management Page Error Status Register, offset: 0x4 */
+    volatile uint32_t MP_INT_LOW;               /*< Management Page Interrupt Request Status Register - Low, offset: 0x8 */
+    volatile uint32_t MP_INT_HIGH;              /**< Management Page Interrupt Request Status Register- High, offset: 0xC */
+    volatile uint32_t MP_HRS_LOW;               /**< Management Page Hardware Request Status Register - Low, offset: 0x10 */
+    volatile uint32_t MP_HRS_HIGH;              /**< Management Page Hardware Request Status Register - High, offset: 0x14 */
+    uint8_t RESERVED_0[232];
+    volatile uint32_t CH_GRPRI[64];             /**< Channel Arbitration Group Register, array offset: 0x100, array step: 0x4 */
+    uint8_t RESERVED_1[65024];
+    struct {                                    /* offset: 0x10000,  */
+        volatile uint32_t CH_CSR;               /**< Channel Control and Status Register, array offset: 0x10000,  */
+        volatile uint32_t CH_ES;                /**< Channel Error Status Register, array offset: 0x10004,  */
+        volatile uint32_t CH_INT;               /**< Channel Interrupt Status Register, array offset: 0x10008,  */
+        volatile uint32_t CH_SBR;               /**< Channel System Bus Register, array offset: 0x1000C,  */
+        volatile uint32_t CH_PRI;               /**< Channel Priority Register, array offset: 0x10010,  */
+        volatile uint32_t CH_MUX;               /**< Channel Multiplexor Configuration, array offset: 0x10014,  */
+        volatile uint32_t CH_MATTR;             /**< Memory Attributes Register, array offset: 0x10018,  */
+        uint8_t RESERVED_0[4];                  /* array offset: 0x1001C */
+        volatile uint32_t SADDR;                /**< TCD Source Address Register, array offset: 0x10020,  */
+        volatile uint32_t SADDR_HIGH;           /**< TCD Source Address Register, array offset: 0x10024,  */
+        volatile uint16_t SOFF;                 /**< TCD Signed Source Address Offset Register, array offset: 0x10028,  */
+        volatile uint16_t ATTR;                 /**< TCD Transfer Attributes Register, array offset: 0x1002A,  */
+        union {                                 /* offset: 0x1002C,  */
+            volatile uint32_t NBYTES_MLOFFNO;   /**< TCD Transfer Size without Minor Loop Offsets Register, array offset: 0x1002C,  */
+            volatile uint32_t NBYTES_MLOFFYES;  /**< TCD Transfer Size with Minor Loop Offsets Register, array offset: 0x1002C,  */
+        };
+        volatile uint32_t SLAST_SDA;            /**< TCD Last Source Address Adjustment / Store DADDR Address Register, array offset: 0x10030,  */
+        volatile uint32_t SLAST_SDA_HIGH;       /**< TCD Last Source Address Adjustment / Store DADDR Address Register, array offset: 0x10034,  */
+        volatile uint32_t DADDR;                /**< TCD Destination Address Register, array offset: 0x10038,  */
+        volatile uint32_t DADDR_HIGH;           /**< TCD Destination Address Register, array offset: 0x1003C,  */
+        volatile uint32_t DLAST_SGA;            /**< TCD Last Destination Address Adjustment / Scatter Gather Address Register, array offset: 0x10040,  */
+        volatile uint32_t DLAST_SGA_HIGH;       /**< TCD Last Destination Address Adjustment / Scatter Gather Address Register, array offset: 0x10044,  */
+        volatile uint16_t DOFF;                 /**< TCD Signed Destination Address Offset Register, array offset: 0x10048,  */
+        union {                                 /* offset: 0x1004A,  */
+            volatile uint16_t CITER_ELINKNO;    /**< TCD Current Major Loop Count (Minor Loop Channel Linking Disabled) Register, array offset: 0x1004A,  */
+            volatile uint16_t CITER_ELINKYES;   /**< TCD Current Major Loop Count (Minor Loop Channel Linking Enabled) Register, array offset: 0x1004A,  */
+        };
+        volatile uint16_t CSR;                  /**< TCD Control and Status Register, array offset: 0x1004C,  */
+        union {                                 /* offset: 0x1004E,  */
+            volatile uint16_t BITER_ELINKNO;    /**< TCD Beginning Major Loop Count (Minor Loop Channel Linking Disabled) Register, array offset: 0x1004E,  */
+            volatile uint16_t BITER_ELINKYES;   /**< TCD Beginning Major Loop Count (Minor Loop Channel Linking Enabled) Register, array offset: 0x1004E,  */
+        };
+        uint8_t RESERVED_1[0x8000 - 0x4E - 2];
+    } TCD[64];
+} DMA_Type;
+
+#define DMA_ATTR_DSIZE_MASK                     (0x7U)
+#define DMA_ATTR_DSIZE_SHIFT                    (0U)
+/*! DSIZE - Destination data transfer size
+ *  0b000..8-bit
+ *  0b001..16-bit
+ *  0b010..32-bit
+ *  0b011..64-bit
+ *  0b100..16-byte
+ *  0b101..32-byte
+ *  0b110..64-byte
+ *  0b111..128-byte
+ */
+#define DMA_ATTR_DSIZE(x)                       (((uint16_t)(((uint16_t)(x)) << DMA_ATTR_DSIZE_SHIFT)) & DMA_ATTR_DSIZE_MASK)
+
+#define DMA_ATTR_SSIZE_MASK                     (0x700U)
+#define DMA_ATTR_SSIZE_SHIFT                    (8U)
+/*! SSIZE - Source data transfer size
+ *  0b000..8-bit
+ *  0b001..16-bit
+ *  0b010..32-bit
+ *  0b011..64-bit
+ *  0b100..16-byte
+ *  0b101..32-byte
+ *  0b110..64-byte
+ *  0b111..128-byte
+ */
+#define DMA_ATTR_SSIZE(x)                       (((uint16_t)(((uint16_t)(x)) << DMA_ATTR_SSIZE_SHIFT)) & DMA_ATTR_SSIZE_MASK)
+
+#define DMA_CH_ES_ERR_MASK                      (0x80000000U)
+#define DMA_CH_CSR_DONE_MASK                    (0x40000000U)
+#define DMA_CSR_START_MASK                      (0x1U)
+#define DMA_CH_INT_INT_MASK                     (0x1U)
+#define DMA_CH_CSR_ACTIVE_MASK                  (0x80000000U)
+
+/* From cortex-m33 view */
+#define CM33_28TH_BIT_MASK (0x10000000)
+#define CM33_ITCM_START_ADDR (0x0FF80000)
+#define CM33_ITCM_END_ADDR   (0x0FFFFFFF)
+#define CM33_DTCM_START_ADDR (0x20000000)
+#define CM33_DTCM_END_ADDR (0x2007FFFF)
+
+/* From dma view */
+#define CM33_ITCM_START_ADDR_FROM_DMA_VIEW  (0x20180000)
+#define CM33_ITCM_END_ADDR_FROM_DMA_VIEW    (0x201FFFFF)
+#define CM33_DTCM_START_ADDR_FROM_DMA_VIEW  (0x20200000)
+#define CM33_DTCM_END_ADDR_FROM_DMA_VIEW    (0x2027FFFF)
+
+
+static unsigned int convert_to_dma_addr(unsigned int cpu_view_addr)
+{
+	unsigned int dst_addr = cpu_view_addr;
+
+	if ((cpu_view_addr >= CM33_ITCM_START_ADDR) && (cpu_view_addr <= CM33_ITCM_END_ADDR))
+	{
+		dst_addr = (int)cpu_view_addr - (int)CM33_ITCM_START_ADDR + CM33_ITCM_START_ADDR_FROM_DMA_VIEW;
+	}
+	if ((cpu_view_addr >= CM33_DTCM_START_ADDR) && (cpu_view_addr <= CM33_DTCM_END_ADDR))
+	{
+		dst_addr = (int)cpu_view_addr - (int)CM33_DTCM_START_ADDR + CM33_DTCM_START_ADDR_FROM_DMA_VIEW;
+	}
+
+	return dst_addr;
+}
+
+/*! @brief DMA transfer configuration */
+typedef enum
+{
+    DMA_TRANSFER_SIZE_1_BYTES = 0x0U, /*!< Source/Destination data transfer size is 1 byte every time */
+    DMA_TRANSFER_SIZE_2_BYTES = 0x1U, /*!< Source/Destination data transfer size is 2 bytes every time */
+    DMA_TRANSFER_SIZE_4_BYTES = 0x2U, /*!< Source/Destination data transfer size is 4 bytes every time */
+    DMA_TRANSFER_SIZE_8_BYTES = 0x3U, /*!< Source/Destination data transfer size is 8 bytes every time */
+    DMA_TRANSFER_SIZE_16_BYTES = 0x4U, /*!< Source/Destination data transfer size is 16 bytes every time */
+    DMA_TRANSFER_SIZE_32_BYTES = 0x5U, /*!< Source/Destination data transfer size is 32 bytes every time */
+    DMA_TRANSFER_SIZE_64_BYTES = 0x6U, /*!< Source/Destination data transfer size is 64 bytes every time */
+    DMA_TRANSFER_SIZE_128_BYTES = 0x7U, /*!< Source/Destination data transfer size is 128 bytes every time */
+} dma_transfer_size_e;
+
+static dma_transfer_size_e dma_width_mapping(unsigned int width)
+{
+    dma_transfer_size_e transfer_size = DMA_TRANSFER_SIZE_1_BYTES;
+
+    /* map width to register value */
+    switch (width)
+    {
+        /* width 8bit */
+        case 1U:
+            transfer_size = DMA_TRANSFER_SIZE_1_BYTES;
+            break;
+        /* width 16bit */
+        case 2U:
+            transfer_size = DMA_TRANSFER_SIZE_2_BYTES;
+            break;
+        /* width 32bit */
+        case 4U:
+            transfer_size = DMA_TRANSFER_SIZE_4_BYTES;
+            break;
+        /* width 64bit */
+        case 8U:
+            transfer_size = DMA_TRANSFER_SIZE_8_BYTES;
+            break;
+        /* width 128bit */
+        case 16U:
+            transfer_size = DMA_TRANSFER_SIZE_16_BYTES;
+            break;
+        /* width 256bit */
+        case 32U:
+            transfer_size = DMA_TRANSFER_SIZE_32_BYTES;
+            break;
+        /* width 512bit */
+        case 64U:
+            transfer_size = DMA_TRANSFER_SIZE_64_BYTES;
+            break;
+        /* width 1024bit */
+        case 128U:
+            transfer_size = DMA_TRANSFER_SIZE_128_BYTES;
+            break;
+        default:
+            /* All the cases have been listed above, the default clause should not be reached. */
+            break;
+    }
+
+    return transfer_size;
+}
+
+int edma_set(unsigned int dma_base_addr, unsigned int src_addr, unsigned int src_width,
+	     int src_off, unsigned int dst_addr, unsigned int dst_width, int dst_off,
+	     unsigned int size, unsigned int iter)
+{
+	int ret = -1;
+
+	DMA_Type *DMA = (DMA_Type *)(dma_base_addr);
+	dma_transfer_size_e src_transfer_size = dma_width_mapping(src_width);
+	dma_transfer_size_e dst_transfer_size = dma_width_mapping(dst_width);
+	
+	/* Check address alignment  */
+	if ((src_addr % src_width) != 0)
+	        return ret;
+	if ((dst_addr % dst_width) != 0)
+	        return ret;
+	
+	/* Configure DMA */
+	DMA->TCD[0].SADDR = convert_to_dma_addr(src_addr & ~(CM33_28TH_BIT_MASK));
+	DMA->TCD[0].SOFF = src_off;
+	DMA->TCD[0].ATTR = DMA_ATTR_SSIZE(src_transfer_size) | DMA_ATTR_DSIZE(dst_transfer_size);
+	//DMA->TCD[0].ATTR = 0x0203;
+	DMA->TCD[0].NBYTES_MLOFFNO = size;
+	DMA->TCD[0].SLAST_SDA = 0;
+	DMA->TCD[0].DADDR = convert_to_dma_addr(dst_addr & ~(CM33_28TH_BIT_MASK));
+	DMA->TCD[0].DOFF = dst_off;
+	DMA->TCD[0].CITER_ELINKNO = iter;
+	DMA->TCD[0].DLAST_SGA = 0;
+	DMA->TCD[0].BITER_ELINKNO = iter;
+	/*
+	 *
+	 * Control status
+	 *
+	 * Disable requestIf this flag is set, the eDMA hardware automatically clears the corresponding ERQ bit when the current major iteration count reaches zero.
+	 * 0b - No operation. The channel’s ERQ {H,L} bit is not affected.
+	 * 1b - Clear the ERQ bit upon major loop completion, thus disabling hardware service requests. The channel’s ERQ {H,L} bit is cleared when the major loop is complete
+	 */
+	DMA->TCD[0].CSR = 0x8;
+	
+	/* clear previous errors and done*/
+	DMA->TCD[0].CH_ES = DMA_CH_ES_ERR_MASK;
+	DMA->TCD[0].CH_CSR = DMA_CH_CSR_DONE_MASK;
+	
+	/*
+	 * The following instructions are needed to guarantee the dma channel is
+	 * active on the first test of the while() loop
+	 */
+	//__asm("DSB;");
+	//__asm("ISB;");
+	ret = 0;
+	
+	return ret;
+}
+
+void edma_start(unsigned int dma_base_addr)
+{
+	DMA_Type *DMA = (DMA_Type *)(dma_base_addr);
+	
+	/* start DMA transfer */
+	DMA->TCD[0].CSR = DMA_CSR_START_MASK;
+}
+
+void edma_clr(unsigned int dma_base_addr)
+{
+	DMA_Type *DMA = (DMA_Type *)(dma_base_addr);
+	
+	/* Configure DMA */
+	DMA->TCD[0].SADDR = 0;
+	DMA->TCD[0].SOFF = 0;
+	DMA->TCD[0].ATTR = 0;
+	DMA->TCD[0].NBYTES_MLOFFNO = 0;
+	DMA->TCD[0].SLAST_SDA = 0;
+	DMA->TCD[0].DADDR = 0;
+	DMA->TCD[0].DOFF = 0;
+	DMA->TCD[0].CITER_ELINKNO = 0;
+	DMA->TCD[0].DLAST_SGA = 0;
+	DMA->TCD[0].BITER_ELINKNO = 0;
+	DMA->TCD[0].CSR = 0;
+	DMA->TCD[0].CH_CSR = DMA_CH_CSR_DONE_MASK;
+	DMA->TCD[0].CH_ES = DMA_CH_ES_ERR_MASK;
+	DMA->TCD[0].CH_INT = DMA_CH_INT_INT_MASK;
+}
+
+int edma_check(unsigned int dma_base_addr)
+{
+	DMA_Type *DMA = (DMA_Type *)(dma_base_addr);
+	
+	int status = 0;
+	
+	/* Poll the dma channel until it completes */
+	while ((DMA->TCD[0].CH_CSR & DMA_CH_CSR_ACTIVE_MASK) != 0U) {
+	}
+	
+	if ((DMA->TCD[0].CH_ES & DMA_CH_ES_ERR_MASK) != 0U) {
+	    status = -1;
+	} else {
+	    status = 0;
+	}
+	
+	return status;
+}
+
+int edma_wait(unsigned int dma_base_addr)
+{
+	DMA_Type *DMA = (DMA_Type *)(dma_base_addr);
+
+	/* Poll the dma channel until the major loop completes */
+	while ((DMA->TCD[0].CH_CSR & DMA_CH_CSR_DONE_MASK) == 0U) {
+		if ((DMA->TCD[0].CH_ES & DMA_CH_ES_ERR_MASK) != 0U)
+			return -1;
+	}
+
+	return 0;
+}
@@ -15,6 +15,31 @@
 
 #define SYSCNT_CTRL_BASE_ADDR   SYSCTRL_CTL_NS_RBASE 
 
+/* PMU cycle counter, cntvct_el0 runs at the 24MHz system counter rate */
+#define PMCR_EL0_E		BIT(0)
+#define PMCNTENSET_EL0_C	BIT(31)
+
+/* Cycle counter calibration window against the system counter */
+#define TIMER_CAL_US		200U
+/* Longer windows start over, before the 32-bit cycle count can wrap */
+#define TIMER_CAL_MAX_US	1000000U
+/* Fraction bits of the ns per cycle */
+#define TIMER_NS_SHIFT		14
+/* Longest delay counted in cycles, longer ones run on the system counter */
+#define TIMER_CYC_DELAY_MAX_US	1000U
+
+/*
+ * Calibration window start, then cycles per us, rounded up, and ns per
+ * cycle, 0 until the window is closed
+ */
+static struct {
+	bool on;
+	uint64_t tick;
+	uint32_t cyc;
+	uint32_t per_us;
+	uint32_t ns;
+} timer_cyc __attribute__((section(".data")));
+
 void timer_enable(void)
 {
 	struct sctr_regs *sctr = (struct sctr_regs *)SYSCNT_CTRL_BASE_ADDR;
@@ -50,15 +75,117 @@ uint32_t timer_get_us(void)
 	return TICKS_TO_USEC(timer_tick());
 }
 
+uint32_t timer_get_cycles(void)
+{
+	uint64_t cyc;
+
+	asm volatile ("mrs %0, pmccntr_el0" : "=r" (cyc));
+
+	return (uint32_t)cyc;
+}
+
+/* open the calibration window on a system counter tick */
+static void timer_cal_start(void)
+{
+	uint64_t start;
+
+	start = timer_tick();
+	while (timer_tick() == start)
+		;
+
+	timer_cyc.tick = timer_tick();
+	timer_cyc.cyc = timer_get_cycles();
+}
+
+/**
+ * Close the calibration window once at least TIMER_CAL_US long, waiting
+ * for it when asked to, true once calibrated
+ */
+static bool timer_cal_update(bool wait)
+{
+	uint64_t ticks;
+	uint32_t cyc, us;
+
+	if (timer_cyc.per_us)
+		return true;
+	if (!timer_cyc.on)
+		return false;
+
+	for (;;) {
+		ticks = timer_tick() - timer_cyc.tick;
+		cyc = timer_get_cycles() - timer_cyc.cyc;
+		if (ticks > USEC_TO_TICKS(TIMER_CAL_MAX_US))
+			timer_cal_start();
+		else if (ticks >= USEC_TO_TICKS(TIMER_CAL_US))
+			break;
+		else if (!wait)
+			return false;
+	}
+
+	if (!cyc) {
+		timer_cyc.on = false;
+		return false;
+	}
+
+	us = TICKS_TO_USEC(ticks);
+	timer_cyc.per_us = (cyc + us - 1) / us;
+	timer_cyc.ns = ((uint64_t)us * 1000U << TIMER_NS_SHIFT) / cyc;
+
+	return true;
+}
+
+/**
+ * Start the PMU cycle counter and its calibration against the system
+ * counter, again after each CPU clock change. The boot goes on meanwhile:
+ * the first cycle use TIMER_CAL_US later closes the window, delays run on
+ * the system counter until then.
+ */
+void timer_calibrate(void)
+{
+	uint64_t pmcr;
+
+	timer_cyc.on = false;
+	timer_cyc.per_us = 0;
+
+	asm volatile ("mrs %0, pmcr_el0" : "=r" (pmcr));
+	asm volatile ("msr pmcr_el0, %0" : : "r" (pmcr | PMCR_EL0_E));
+	asm volatile ("msr pmcntenset_el0, %0" : : "r" ((uint64_t)PMCNTENSET_EL0_C));
+	asm volatile ("isb" : : : "memory");
+
+	timer_cal_start();
+	timer_cyc.on = true;
+}
+
+/* Profiling only, waits for the end of the calibration window if needed */
+uint32_t timer_cycles_to_ns(uint32_t cycles)
+{
+	if (!timer_cal_update(true))
+		return 0;
+
+	return (uint32_t)(((uint64_t)cycles * timer_cyc.ns) >> TIMER_NS_SHIFT);
+}
+
 bool time_after(uint32_t us, uint32_t timeout)
 {
 	return (timer_get_us() + timeout > us);
 }
 
+/* Delays up to TIMER_CYC_DELAY_MAX_US are counted in CPU cycles once calibrated */
 void udelay(uint32_t us)
 {
-	uint64_t startTicks = timer_tick();
-	uint64_t delayTicks = USEC_TO_TICKS(us);
+	uint64_t startTicks, delayTicks;
+	uint32_t start, cycles;
+
+	if (us <= TIMER_CYC_DELAY_MAX_US && timer_cal_update(false)) {
+		start = timer_get_cycles();
+		cycles = us * timer_cyc.per_us;
+		while (timer_get_cycles() - start < cycles)
+			;
+		return;
+	}
+
+	startTicks = timer_tick();
+	delayTicks = USEC_TO_TICKS(us);
 
 	while ((timer_tick() - startTicks) < delayTicks)
 	{
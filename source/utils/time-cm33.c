@@ -9,11 +9,39 @@
 #include <time.h>
 
 /* generic timer come from system counter which is running on 24MHz */
-#define TICKS_TO_USEC(ticks)	(uint32_t)(((uint32_t)ticks) / 24UL)
 #define USEC_TO_TICKS(usec)	((uint64_t)(usec) * 24UL)
 
 #define SYSCNT_CTRL_BASE_ADDR	SYSCTRL_CTL_RBASE
 
+/* DWT cycle counter */
+#define DEMCR			0xE000EDFCU
+#define DEMCR_TRCENA		BIT(24)
+#define DWT_CTRL		0xE0001000U
+#define DWT_CTRL_NOCYCCNT	BIT(25)
+#define DWT_CTRL_CYCCNTENA	BIT(0)
+#define DWT_CYCCNT		0xE0001004U
+
+/* Cycle counter calibration window against the system counter */
+#define TIMER_CAL_US		200U
+/* Longer windows start over, before the 32-bit cycle count can wrap */
+#define TIMER_CAL_MAX_US	1000000U
+/* Fraction bits of the ns per cycle */
+#define TIMER_NS_SHIFT		14
+/* Longest delay counted in cycles, longer ones run on the system counter */
+#define TIMER_CYC_DELAY_MAX_US	1000U
+
+/*
+ * Calibration window start, then cycles per us, rounded up, and ns per
+ * cycle, 0 until the window is closed
+ */
+static struct {
+	bool on;
+	uint64_t tick;
+	uint32_t cyc;
+	uint32_t per_us;
+	uint32_t ns;
+} timer_cyc __attribute__((section(".data")));
+
 void timer_enable(void)
 {
 	struct sctr_regs *sctr = (struct sctr_regs *)SYSCNT_CTRL_BASE_ADDR;
@@ -51,9 +79,128 @@ uint64_t timer_tick(void)
 	return ticks;
 }
 
+/* ticks / 24 without a 64-bit division, 16 bits at a time */
+static uint32_t ticks_to_usec(uint64_t ticks)
+{
+	uint32_t q = 0, rem = 0, d;
+	int i;
+
+	for (i = 48; i >= 0; i -= 16) {
+		d = (rem << 16) | ((uint32_t)(ticks >> i) & 0xffff);
+		q = (q << 16) | (d / 24U);
+		rem = d % 24U;
+	}
+
+	return q;
+}
+
 uint32_t timer_get_us(void)
 {
-	return TICKS_TO_USEC(timer_tick());
+	return ticks_to_usec(timer_tick());
+}
+
+/* n / d without a 64-bit division, one bit at a time */
+static uint32_t div_u64_u32(uint64_t n, uint32_t d)
+{
+	uint64_t rem = 0;
+	uint32_t q = 0;
+	int i;
+
+	for (i = 63; i >= 0; i--) {
+		rem = (rem << 1) | ((n >> i) & 1U);
+		q <<= 1;
+		if (rem >= d) {
+			rem -= d;
+			q |= 1U;
+		}
+	}
+
+	return q;
+}
+
+/* open the calibration window on a system counter tick */
+static void timer_cal_start(void)
+{
+	uint64_t start;
+
+	start = timer_tick();
+	while (timer_tick() == start)
+		;
+
+	timer_cyc.tick = timer_tick();
+	timer_cyc.cyc = readl(DWT_CYCCNT);
+}
+
+/**
+ * Close the calibration window once at least TIMER_CAL_US long, waiting
+ * for it when asked to, true once calibrated
+ */
+static bool timer_cal_update(bool wait)
+{
+	uint64_t ticks;
+	uint32_t cyc, us;
+
+	if (timer_cyc.per_us)
+		return true;
+	if (!timer_cyc.on)
+		return false;
+
+	for (;;) {
+		ticks = timer_tick() - timer_cyc.tick;
+		cyc = readl(DWT_CYCCNT) - timer_cyc.cyc;
+		if (ticks > USEC_TO_TICKS(TIMER_CAL_MAX_US))
+			timer_cal_start();
+		else if (ticks >= USEC_TO_TICKS(TIMER_CAL_US))
+			break;
+		else if (!wait)
+			return false;
+	}
+
+	if (!cyc) {
+		timer_cyc.on = false;
+		return false;
+	}
+
+	us = ticks_to_usec(ticks);
+	timer_cyc.per_us = (cyc + us - 1) / us;
+	timer_cyc.ns = div_u64_u32((uint64_t)us * 1000U << TIMER_NS_SHIFT, cyc);
+
+	return true;
+}
+
+/**
+ * Start the DWT cycle counter and its calibration against the system
+ * counter, again after each CPU clock change. The boot goes on meanwhile:
+ * the first cycle use TIMER_CAL_US later closes the window, delays run on
+ * the system counter until then.
+ */
+void timer_calibrate(void)
+{
+	timer_cyc.on = false;
+	timer_cyc.per_us = 0;
+
+	if (readl(DWT_CTRL) & DWT_CTRL_NOCYCCNT)
+		return;
+
+	setbits_le32(DEMCR, DEMCR_TRCENA);
+	setbits_le32(DWT_CTRL, DWT_CTRL_CYCCNTENA);
+
+	timer_cal_start();
+	timer_cyc.on = true;
+}
+
+uint32_t timer_get_cycles(void)
+{
+	return readl(DWT_CYCCNT);
+}
+
+/* Profiling only, waits for the end of the calibration window if needed */
+uint32_t timer_cycles_to_ns(uint32_t cycles)
+{
+	if (!timer_cal_update(true))
+		return 0;
+
+	return (uint32_t)(((uint64_t)cycles * timer_cyc.ns) >> TIMER_NS_SHIFT);
 }
 
 bool time_after(uint32_t us, uint32_t timeout)
@@ -61,10 +208,22 @@ bool time_after(uint32_t us, uint32_t timeout)
 	return (timer_get_us() + timeout > us);
 }
 
+/* Delays up to TIMER_CYC_DELAY_MAX_US are counted in CPU cycles once calibrated */
 void udelay(uint32_t us)
 {
-	uint64_t startTicks = timer_tick();
-	uint64_t delayTicks = USEC_TO_TICKS(us);
+	uint64_t startTicks, delayTicks;
+	uint32_t start, cycles;
+
+	if (us <= TIMER_CYC_DELAY_MAX_US && timer_cal_update(false)) {
+		start = readl(DWT_CYCCNT);
+		cycles = us * timer_cyc.per_us;
+		while (readl(DWT_CYCCNT) - start < cycles)
+			;
+		return;
+	}
+
+	startTicks = timer_tick();
+	delayTicks = USEC_TO_TICKS(us);
 
 	while ((timer_tick() - startTicks) < delayTicks)
 	{
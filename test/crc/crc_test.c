@@ -0,0 +1,117 @@
+// SPDX-License-Identifier: GPL-2.0+
+/*
+ * Copyright 2024 NXP
+ *
+ * Host test of source/utils/crc.c: each backend, linked under its own
+ * name, is checked against CRC-32 vectors and against the nibble table
+ * on every length/alignment pair and a split update, then timed.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+typedef unsigned int (*crc32_update_fn)(unsigned int crc, const void *addr, unsigned int len);
+
+#define CRC32_BACKEND(name) \
+	unsigned int crc32_update_##name(unsigned int crc, const void *addr, unsigned int len); \
+	unsigned int crc32_##name(const void *addr, unsigned int len);
+
+CRC32_BACKEND(nibble)
+CRC32_BACKEND(slice4)
+CRC32_BACKEND(slice8)
+#if defined(CRC_TEST_ARMV8)
+CRC32_BACKEND(armv8)
+#endif
+
+static const struct {
+	const char *name;
+	crc32_update_fn update;
+	unsigned int (*crc)(const void *addr, unsigned int len);
+} backends[] = {
+	{ "nibble", crc32_update_nibble, crc32_nibble },
+	{ "slice4", crc32_update_slice4, crc32_slice4 },
+	{ "slice8", crc32_update_slice8, crc32_slice8 },
+#if defined(CRC_TEST_ARMV8)
+	{ "armv8", crc32_update_armv8, crc32_armv8 },
+#endif
+};
+
+#define NUM_BACKENDS	(sizeof(backends) / sizeof(backends[0]))
+
+static const struct {
+	const char *data;
+	unsigned int crc;
+} vectors[] = {
+	{ "", 0x00000000 },
+	{ "a", 0xe8b7be43 },
+	{ "abc", 0x352441c2 },
+	{ "123456789", 0xcbf43926 },
+	{ "The quick brown fox jumps over the lazy dog", 0x414fa339 },
+};
+
+#define VEC_MAX		1024
+#define BENCH_SIZE	(1024 * 1024)
+#define BENCH_LOOPS	32
+
+static unsigned char buf[BENCH_SIZE + 8] __attribute__((aligned(8)));
+
+static double now(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+int main(void)
+{
+	unsigned int i, b, len, off, ref, crc, fail = 0;
+	double t, mbs, base = 0;
+
+	srand(1);
+	for (i = 0; i < sizeof(buf); i++)
+		buf[i] = rand();
+
+	for (b = 0; b < NUM_BACKENDS; b++) {
+		for (i = 0; i < sizeof(vectors) / sizeof(vectors[0]); i++) {
+			crc = backends[b].crc(vectors[i].data, strlen(vectors[i].data));
+			if (crc != vectors[i].crc) {
+				printf("%s: \"%s\": 0x%08x, expected 0x%08x\n", backends[b].name,
+				       vectors[i].data, crc, vectors[i].crc);
+				fail++;
+			}
+		}
+
+		/* every length up to VEC_MAX from every offset of a doubleword */
+		for (off = 0; off < 8; off++) {
+			for (len = 0; len <= VEC_MAX; len++) {
+				ref = crc32_nibble(buf + off, len);
+				crc = backends[b].crc(buf + off, len);
+				if (crc == ref)
+					crc = backends[b].update(backends[b].crc(buf + off, len / 3),
+								 buf + off + len / 3, len - len / 3);
+				if (crc != ref) {
+					printf("%s: %u bytes at +%u: 0x%08x, expected 0x%08x\n",
+					       backends[b].name, len, off, crc, ref);
+					fail++;
+				}
+			}
+		}
+	}
+
+	printf("%-8s %10s %8s\n", "backend", "MB/s", "speedup");
+	for (b = 0; b < NUM_BACKENDS; b++) {
+		t = now();
+		for (i = 0, crc = 0; i < BENCH_LOOPS; i++)
+			crc = backends[b].update(crc, buf, BENCH_SIZE);
+		t = now() - t;
+		mbs = (double)BENCH_LOOPS * BENCH_SIZE / t / 1e6;
+		if (!b)
+			base = mbs;
+		printf("%-8s %10.1f %7.1fx\n", backends[b].name, mbs, mbs / base);
+	}
+
+	printf("%s, %u failure(s)\n", fail ? "FAILED" : "passed", fail);
+	return fail ? 1 : 0;
+}
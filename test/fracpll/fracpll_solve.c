@@ -0,0 +1,57 @@
+// SPDX-License-Identifier: GPL-2.0+
+/*
+ * Copyright 2024 NXP
+ *
+ * fracpll_solve() and dram_enable_bypass() of source/clocks/clock_common.c,
+ * built with the repo headers and exported to fracpll_test.c. The rest of
+ * the file is dropped at link time.
+ */
+#include "../../source/clocks/clock_common.c"
+
+/* div: rdiv, mfi, odiv, mfn, mfd */
+int fracpll_test_solve(u32 freq, u32 *div)
+{
+	struct imx_fracpll_rate_table rate;
+	int ret;
+
+	ret = fracpll_solve(freq, &rate);
+	div[0] = rate.rdiv;
+	div[1] = rate.mfi;
+	div[2] = rate.odiv;
+	div[3] = rate.mfn;
+	div[4] = rate.mfd;
+
+	return ret;
+}
+
+/* DRAM_ALT_CLK_ROOT source, as a PFD index, and divider set by the bypass */
+static int bypass_pfd = -1;
+static u32 bypass_div;
+
+int ccm_clk_root_cfg(u32 clk_root_id, enum ccm_clk_src src, u32 div)
+{
+	if (clk_root_id == DRAM_ALT_CLK_ROOT) {
+		bypass_pfd = src == SYS_PLL_PFD0 ? 0 : src == SYS_PLL_PFD1 ? 1 :
+			     src == SYS_PLL_PFD2 ? 2 : -1;
+		bypass_div = div;
+	}
+
+	return 0;
+}
+
+int ccm_shared_gpr_set(u32 gpr, u32 val)
+{
+	return 0;
+}
+
+int fracpll_test_bypass(u32 mhz, int *pfd, u32 *div)
+{
+	int ret;
+
+	bypass_pfd = -1;
+	ret = dram_enable_bypass(MHZ(mhz));
+	*pfd = bypass_pfd;
+	*div = bypass_div;
+
+	return ret;
+}
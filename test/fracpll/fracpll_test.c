@@ -0,0 +1,182 @@
+// SPDX-License-Identifier: GPL-2.0+
+/*
+ * Copyright 2024 NXP
+ *
+ * Host test of fracpll_solve() (source/clocks/clock_common.c): the former
+ * imx9_fracpll_tbl[] rates are solved and compared with the table
+ * dividers, then every rate from 10 MHz to 2.5 GHz in 10 kHz steps is
+ * checked. The dividers have to fit their register fields, keep the VCO
+ * in 2.5-5 GHz and give the requested rate exactly. The DRAM clock root
+ * divider of the CCM bypass is checked against the former cases and for
+ * every rate from 2 to 625 MHz.
+ */
+#include <stdio.h>
+
+#define FREF		24000000ULL
+#define VCO_MIN		2500000000ULL
+#define VCO_MAX		5000000000ULL
+#define SWEEP_MIN	10000000U
+#define SWEEP_MAX	2500000000U
+#define SWEEP_STEP	10000U
+
+int fracpll_test_solve(unsigned int freq, unsigned int *div);
+int fracpll_test_bypass(unsigned int mhz, int *pfd, unsigned int *div);
+
+/* system PLL PFD0-2 rates in MHz */
+static const unsigned int pfd_mhz[] = { 1000, 800, 625 };
+
+/* former dram_enable_bypass() cases: MHz, PFD, divider */
+static const unsigned int bypass_tbl[][3] = {
+	{ 625, 2, 1 },
+	{ 400, 1, 2 },
+	{ 333, 0, 3 },
+	{ 200, 1, 4 },
+	{ 100, 1, 8 },
+};
+
+/* imx9_fracpll_tbl[] before user-022: rate, rdiv, mfi, odiv, mfn, mfd */
+static const unsigned int tbl[][6] = {
+	{ 1066666666U, 1, 133, 3, 1, 3 },
+	{ 1000000000U, 1, 166, 4, 2, 3 },
+	{ 933333333U, 1, 155, 4, 5, 9 },
+	{ 933000000U, 1, 155, 4, 1, 2 },
+	{ 800000000U, 1, 200, 6, 0, 1 },
+	{ 700000000U, 1, 145, 5, 5, 6 },
+	{ 600000000U, 1, 200, 8, 0, 1 },
+	{ 533333333U, 1, 133, 6, 1, 3 },
+	{ 484000000U, 1, 121, 6, 0, 1 },
+	{ 466666666U, 1, 155, 8, 5, 9 },
+	{ 466000000U, 1, 155, 8, 1, 3 },
+	{ 400000000U, 1, 200, 12, 0, 1 },
+	{ 300000000U, 1, 150, 12, 0, 1 },
+	{ 266666666U, 1, 177, 16, 7, 9 },
+	{ 233333333U, 1, 155, 16, 5, 9 },
+	{ 233000000U, 1, 174, 18, 3, 4 },
+	{ 200000000U, 1, 200, 24, 0, 1 },
+	{ 100000000U, 1, 200, 48, 0, 1 },
+};
+
+/* VCO in Hz, as a fraction over mfd */
+static unsigned long long vco_num(const unsigned int *div)
+{
+	return FREF * ((unsigned long long)div[1] * div[4] + div[3]) / div[0];
+}
+
+static double out_hz(const unsigned int *div)
+{
+	return (double)vco_num(div) / div[4] / div[2];
+}
+
+static const char *div_str(char *buf, const unsigned int *div)
+{
+	snprintf(buf, 48, "%u+%u/%u, /%u", div[1], div[3], div[4], div[2]);
+	return buf;
+}
+
+/* dividers fit their fields, VCO in range, output freq exactly */
+static int check(unsigned int freq, const unsigned int *div)
+{
+	unsigned long long num = vco_num(div);
+
+	if (div[0] != 1 || div[2] < 2 || div[2] > 255 || div[1] > 511 ||
+	    !div[4] || div[3] >= div[4] || div[4] >= (1U << 30))
+		return -1;
+	if (num < VCO_MIN * div[4] || num > VCO_MAX * div[4])
+		return -2;
+	if (num != (unsigned long long)freq * div[2] * div[4])
+		return -3;
+
+	return 0;
+}
+
+int main(void)
+{
+	unsigned int i, d, freq, rate, div[5], fail = 0, solved = 0, none = 0;
+	int pfd;
+	char buf[2][48];
+	double table, solver;
+
+	printf("%10s  %-16s %14s  %-28s %14s\n", "rate", "table", "Hz", "solver", "Hz");
+	for (i = 0; i < sizeof(tbl) / sizeof(tbl[0]); i++) {
+		if (fracpll_test_solve(tbl[i][0], div) || check(tbl[i][0], div)) {
+			printf("%u: no valid dividers\n", tbl[i][0]);
+			fail++;
+			continue;
+		}
+		table = out_hz((const unsigned int[]){ 1, tbl[i][2], tbl[i][3], tbl[i][4],
+						       tbl[i][5] });
+		solver = out_hz(div);
+		printf("%10u  %-16s %14.2f  %-28s %14.2f\n", tbl[i][0],
+		       div_str(buf[0], (const unsigned int[]){ 1, tbl[i][2], tbl[i][3], tbl[i][4],
+							       tbl[i][5] }),
+		       table, div_str(buf[1], div), solver);
+		/* the table rates are its divider outputs truncated to Hz */
+		if (solver - table >= 1 || table - solver >= 1) {
+			printf("%u: solver and table differ\n", tbl[i][0]);
+			fail++;
+		}
+	}
+
+	for (freq = SWEEP_MIN; freq <= SWEEP_MAX; freq += SWEEP_STEP) {
+		if (fracpll_test_solve(freq, div)) {
+			/* only rates no ODIV brings into the VCO range */
+			if ((unsigned long long)freq * 255 >= VCO_MIN && freq * 2ULL <= VCO_MAX) {
+				printf("%u: not solved\n", freq);
+				fail++;
+			}
+			none++;
+			continue;
+		}
+		if (check(freq, div)) {
+			printf("%u: invalid dividers %u+%u/%u/%u (%d)\n", freq,
+			       div[1], div[3], div[4], div[2], check(freq, div));
+			fail++;
+		}
+		solved++;
+	}
+	/* no ODIV brings these into the VCO range */
+	if (!fracpll_test_solve(9000000U, div) || !fracpll_test_solve(2600000000U, div)) {
+		printf("rate out of the VCO range solved\n");
+		fail++;
+	}
+
+	for (i = 0; i < sizeof(bypass_tbl) / sizeof(bypass_tbl[0]); i++) {
+		if (fracpll_test_bypass(bypass_tbl[i][0], &pfd, &div[0]) ||
+		    pfd != (int)bypass_tbl[i][1] || div[0] != bypass_tbl[i][2]) {
+			printf("bypass %u MHz: PFD%d / %u, expected PFD%u / %u\n", bypass_tbl[i][0],
+			       pfd, div[0], bypass_tbl[i][1], bypass_tbl[i][2]);
+			fail++;
+		}
+	}
+
+	/* any other bypass rate gets the closest PFD rate not above it */
+	if (!fracpll_test_bypass(1, &pfd, &div[0])) {
+		printf("bypass 1 MHz: below PFD2 / 256, set\n");
+		fail++;
+	}
+	for (freq = 2; freq <= 625; freq++) {
+		if (fracpll_test_bypass(freq, &pfd, &div[0]) || pfd < 0) {
+			printf("bypass %u MHz: not set\n", freq);
+			fail++;
+			continue;
+		}
+		rate = pfd_mhz[pfd] / div[0];
+		for (i = 0; i < 3; i++) {
+			for (d = 1; d <= 256; d++) {
+				if (pfd_mhz[i] / d <= freq && pfd_mhz[i] / d > rate) {
+					printf("bypass %u MHz: %u MHz, PFD%u / %u gives %u MHz\n",
+					       freq, rate, i, d, pfd_mhz[i] / d);
+					fail++;
+				}
+			}
+		}
+		if (freq == 500 || freq == 300)
+			printf("bypass %u MHz: PFD%d / %u, %u MHz\n", freq, pfd, div[0], rate);
+	}
+
+	printf("%u-%u Hz in %u Hz steps: %u solved, %u out of range\n",
+	       SWEEP_MIN, SWEEP_MAX, SWEEP_STEP, solved, none);
+
+	printf("%s, %u failure(s)\n", fail ? "FAILED" : "passed", fail);
+	return fail ? 1 : 0;
+}
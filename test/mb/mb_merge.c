@@ -0,0 +1,70 @@
+// SPDX-License-Identifier: GPL-2.0+
+/*
+ * Copyright 2024 NXP
+ *
+ * Message block merge of source/ddr/helper.c, built with the repo headers
+ * along with the former per-halfword merge of the training DMEM load. Only
+ * the merge functions are linked, the rest of the sources is collected.
+ */
+#include "../../source/ddr/helper.c"
+#include "../../source/ddr/ddrphy_utils.c"
+
+/**
+ * Former merge: each halfword of the block looked the FSP overrides up
+ * from the last match on, relying on fsp_phy_msgh_cfg in ascending order.
+ */
+static void check_cfg_id(struct dram_fsp_msg *fsp_msg, u32 reg, u32 *cfg_id, u16 *val)
+{
+	struct ddrphy_cfg_param *cfg = fsp_msg->fsp_phy_msgh_cfg;
+	u32 cfg_num = fsp_msg->fsp_phy_msgh_cfg_num;
+	u32 id = (*cfg_id);
+
+	while (id < cfg_num && ((cfg[id].reg & 0xff000) != DMEM_OFFSET_ADDR || reg > cfg[id].reg))
+		id++;
+
+	*val = (id == cfg_num || reg < cfg[id].reg ? 0 : cfg[id].val);
+	*cfg_id = id;
+}
+
+void mb_test_merge_ref(unsigned short *mb, unsigned int fsp)
+{
+	struct dram_fsp_msg *fsp_msg = &dram_timing.fsp_msg[fsp];
+	u32 i, cfg_id = 0;
+
+	for (i = 0; i < DDRPHY_QB_MSB_SIZE; i++)
+		check_cfg_id(fsp_msg, DMEM_OFFSET_ADDR + i, &cfg_id, &mb[i]);
+}
+
+void mb_test_merge(unsigned short *mb, unsigned int fsp)
+{
+	ddrphy_prepare_mb(mb, &dram_timing.fsp_msg[fsp]);
+}
+
+/* Reverse the FSP overrides, the merge does not depend on their order */
+void mb_test_reverse(unsigned int fsp)
+{
+	struct dram_fsp_msg *fsp_msg = &dram_timing.fsp_msg[fsp];
+	struct ddrphy_cfg_param *cfg = fsp_msg->fsp_phy_msgh_cfg, tmp;
+	u32 i, n = fsp_msg->fsp_phy_msgh_cfg_num;
+
+	for (i = 0; i < n / 2; i++) {
+		tmp = cfg[i];
+		cfg[i] = cfg[n - 1 - i];
+		cfg[n - 1 - i] = tmp;
+	}
+}
+
+unsigned int mb_test_fsp_num(void)
+{
+	return dram_timing.fsp_msg_num;
+}
+
+unsigned int mb_test_msgh_num(unsigned int fsp)
+{
+	return dram_timing.fsp_msg[fsp].fsp_phy_msgh_cfg_num;
+}
+
+unsigned int mb_test_size(void)
+{
+	return DDRPHY_QB_MSB_SIZE;
+}
@@ -0,0 +1,81 @@
+// SPDX-License-Identifier: GPL-2.0+
+/*
+ * Copyright 2024 NXP
+ *
+ * Host test of the DMEM message block merge, ddrphy_prepare_mb(): for each
+ * FSP of a board timing file the block has to match the former per-halfword
+ * merge, and still match once the FSP overrides are reversed. Both merges
+ * are then timed.
+ */
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+void mb_test_merge_ref(unsigned short *mb, unsigned int fsp);
+void mb_test_merge(unsigned short *mb, unsigned int fsp);
+void mb_test_reverse(unsigned int fsp);
+unsigned int mb_test_fsp_num(void);
+unsigned int mb_test_msgh_num(unsigned int fsp);
+unsigned int mb_test_size(void);
+
+#define MB_MAX		1024
+#define BENCH_LOOPS	20000
+
+static unsigned short ref[MB_MAX], mb[MB_MAX];
+
+static double now(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static double bench(void (*merge)(unsigned short *mb, unsigned int fsp), unsigned int fsp)
+{
+	unsigned int i;
+	double t;
+
+	t = now();
+	for (i = 0; i < BENCH_LOOPS; i++)
+		merge(mb, fsp);
+	t = now() - t;
+
+	return t / BENCH_LOOPS * 1e9;
+}
+
+int main(int argc, char **argv)
+{
+	const char *name = argc > 1 ? argv[1] : "";
+	unsigned int fsp, size = mb_test_size(), fail = 0;
+	double t_ref, t;
+
+	if (size > MB_MAX) {
+		printf("%s: message block of %u halfwords\n", name, size);
+		return 1;
+	}
+
+	for (fsp = 0; fsp < mb_test_fsp_num(); fsp++) {
+		mb_test_merge_ref(ref, fsp);
+		mb_test_merge(mb, fsp);
+		if (memcmp(ref, mb, size * sizeof(mb[0]))) {
+			printf("%s: FSP %u message block differs\n", name, fsp);
+			fail++;
+		}
+
+		t_ref = bench(mb_test_merge_ref, fsp);
+		t = bench(mb_test_merge, fsp);
+		printf("%s: FSP %u, %u overrides: block built in %.0f ns, was %.0f ns\n",
+		       name, fsp, mb_test_msgh_num(fsp), t, t_ref);
+
+		mb_test_reverse(fsp);
+		mb_test_merge(mb, fsp);
+		if (memcmp(ref, mb, size * sizeof(mb[0]))) {
+			printf("%s: FSP %u message block depends on the override order\n", name, fsp);
+			fail++;
+		}
+	}
+
+	printf("%s: %s, %u failure(s)\n", name, fail ? "FAILED" : "passed", fail);
+	return fail ? 1 : 0;
+}
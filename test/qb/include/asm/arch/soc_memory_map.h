@@ -0,0 +1,18 @@
+/* SPDX-License-Identifier: GPL-2.0+ */
+/*
+ * Copyright 2024 NXP
+ *
+ * Host build of the memory map: the DDR PHY APB window is the simulated
+ * PHY register file of qb_test.c.
+ */
+#ifndef QB_TEST_SOC_MEMORY_MAP_H
+#define QB_TEST_SOC_MEMORY_MAP_H
+
+#include_next <asm/arch/soc_memory_map.h>
+
+extern unsigned int qb_sim_phy[];
+
+#undef DDRPHY_BASE
+#define DDRPHY_BASE		((unsigned long)qb_sim_phy)
+
+#endif
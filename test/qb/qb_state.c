@@ -0,0 +1,300 @@
+// SPDX-License-Identifier: GPL-2.0+
+/*
+ * Copyright 2024 NXP
+ *
+ * QuickBoot state save of source/ddr/ddrphy_qb_gen.c and its checks,
+ * slots and restore from source/ddr/ddrphy_qb.c, built with the repo
+ * headers. The state is saved to qb_test_state instead of QB_STATE_MEM,
+ * the image slots are qb_test_image; ddr_cfg_phy_qb() itself is not
+ * linked. A training-only build has the save only.
+ */
+#include "ddr.h"
+
+#define QB_TEST_IMAGE_SIZE	(DDRPHY_QB_SLOTS * DDRPHY_QB_SLOT_SIZE)
+
+static u32 qb_test_state[DDRPHY_QB_STATE_MAX / sizeof(u32) + 1];
+static u32 qb_test_image[QB_TEST_IMAGE_SIZE / sizeof(u32)];
+
+#undef QB_STATE_MEM
+#define QB_STATE_MEM		((unsigned long)qb_test_state)
+
+#include "../../source/ddr/ddrphy_qb_gen.c"
+#if defined(DDR_QB_FLOW)
+#include "../../source/ddr/ddrphy_qb.c"
+
+/* the image is linked below 4 GiB, see the Makefile */
+u32 ddr_get_qb_state_addr(void)
+{
+	return (u32)(unsigned long)qb_test_image;
+}
+#endif
+
+/* CPU copy of source/ddr/helper.c, without PHY_EDMA */
+void ddrphy_sram_xfer_start(struct ddrphy_sram_xfer *xfer, u16 *buf, u32 addr, u32 num,
+			    bool to_phy)
+{
+	xfer->buf = buf;
+	xfer->addr = addr;
+	xfer->num = num;
+	xfer->to_phy = to_phy;
+	xfer->dma = false;
+}
+
+void ddrphy_sram_xfer_wait(struct ddrphy_sram_xfer *xfer)
+{
+	u32 i;
+
+	for (i = 0; i < xfer->num; i++) {
+		if (xfer->to_phy)
+			dwc_ddrphy_apb_wr(xfer->addr + i, xfer->buf[i]);
+		else
+			xfer->buf[i] = dwc_ddrphy_apb_rd(xfer->addr + i);
+	}
+}
+
+/* PHY state and trained values the QuickBoot state is saved from */
+static u16 qb_ref_csr[DDRPHY_QB_CSR_SIZE];
+static u16 qb_ref_acsm[DDRPHY_QB_ACSM_SIZE];
+static u16 qb_ref_pst[DDRPHY_QB_PST_SIZE];
+static ddrphy_qb_mr qb_ref_mr[DDRPHY_QB_FSP_MAX];
+
+static u32 qb_test_seed;
+
+static u16 qb_test_rand(void)
+{
+	qb_test_seed = qb_test_seed * 1103515245 + 12345;
+	return qb_test_seed >> 16;
+}
+
+/* Register values: random, constant or trained-like, mostly 0 with short runs */
+static u16 qb_test_val(u32 mode)
+{
+	switch (mode) {
+	case 0:
+		return qb_test_rand();
+	case 1:
+		return 0x1234;
+	default:
+		return qb_test_rand() % 4 ? 0 : qb_test_rand() % 3;
+	}
+}
+
+static void qb_test_fill(u16 *ref, u32 addr, u32 num, u32 mode)
+{
+	u32 i;
+
+	for (i = 0; i < num; i++) {
+		ref[i] = qb_test_val(mode);
+		dwc_ddrphy_apb_wr(addr + i, ref[i]);
+	}
+}
+
+static const char *qb_test_cmp(const u16 *ref, u32 addr, u32 num, const char *name)
+{
+	u32 i;
+
+	for (i = 0; i < num; i++)
+		if (dwc_ddrphy_apb_rd(addr + i) != ref[i])
+			return name;
+
+	return NULL;
+}
+
+static void qb_test_clear(u32 addr, u32 num)
+{
+	u32 i;
+
+	for (i = 0; i < num; i++)
+		dwc_ddrphy_apb_wr(addr + i, 0xdead);
+}
+
+/* Fill the PHY and save the QuickBoot state, returns its size in bytes */
+unsigned int qb_test_save(unsigned int mode, unsigned int seed)
+{
+	ddrphy_qb_hdr *hdr = (ddrphy_qb_hdr *)QB_STATE_MEM;
+	struct ddrphy_csr_iter csr;
+	u32 i;
+
+	qb_test_seed = seed;
+	ddrphy_csr_first(&csr);
+	for (i = 0; i < DDRPHY_QB_CSR_SIZE; i++) {
+		qb_ref_csr[i] = qb_test_val(mode);
+		dwc_ddrphy_apb_wr(ddrphy_csr_next(&csr), qb_ref_csr[i]);
+	}
+	qb_test_fill(qb_ref_acsm, ACSM_SRAM_BASE_ADDR, DDRPHY_QB_ACSM_SIZE, mode);
+	qb_test_fill(qb_ref_pst, PSTATE_SRAM_BASE_ADDR, DDRPHY_QB_PST_SIZE, mode);
+	for (i = 0; i < sizeof(qb_ref_mr); i++)
+		((u8 *)qb_ref_mr)[i] = qb_test_rand();
+
+	ddrphy_qb_save(&dram_timing, qb_ref_mr);
+
+	return hdr->size + sizeof(u32);
+}
+
+/* Saved state, header.size + 4 bytes, as dumped from QB_STATE_MEM */
+const void *qb_test_state_data(unsigned int *size)
+{
+	ddrphy_qb_hdr *hdr = (ddrphy_qb_hdr *)QB_STATE_MEM;
+
+	*size = hdr->size + sizeof(u32);
+	return hdr;
+}
+
+/* Image slots, slot 0 first */
+void *qb_test_image_data(unsigned int *size)
+{
+	*size = sizeof(qb_test_image);
+	return qb_test_image;
+}
+
+unsigned int qb_test_slot_size(void)
+{
+	return DDRPHY_QB_SLOT_SIZE;
+}
+
+unsigned int qb_test_raw_size(void)
+{
+	return sizeof(ddrphy_qb_hdr) + dram_timing.fsp_msg_num * sizeof(ddrphy_qb_mr) +
+	       (DDRPHY_QB_CSR_SIZE + DDRPHY_QB_ACSM_SIZE + DDRPHY_QB_PST_SIZE) * sizeof(u16) +
+	       sizeof(u32);
+}
+
+#if defined(DDR_QB_FLOW)
+/**
+ * Check the saved state and restore its sections to a cleared PHY the way
+ * ddr_cfg_phy_qb() does, returns the name of the first mismatch or NULL
+ */
+const char *qb_test_restore(void)
+{
+	ddrphy_qb_hdr *hdr = (ddrphy_qb_hdr *)QB_STATE_MEM;
+#if !defined(CONFIG_DDR_QB_COMPRESS)
+	struct ddrphy_sram_xfer sram;
+#endif
+	const ddrphy_qb_mr *mr;
+	const char *err;
+	u32 i;
+
+	if (ddrphy_qb_check_hdr(hdr, &dram_timing))
+		return "header";
+	if (*(u32 *)((u8 *)hdr + hdr->size) != ~hdr->crc)
+		return "commit word";
+	if (!ddrphy_qb_sects_ok(hdr, DDRPHY_QB_SECT_MR, DDRPHY_QB_SECT_PST))
+		return "section CRC";
+
+	mr = ddrphy_qb_sect(hdr, DDRPHY_QB_SECT_MR);
+	for (i = 0; i < dram_timing.fsp_msg_num * sizeof(*mr); i++)
+		if (((const u8 *)mr)[i] != ((const u8 *)qb_ref_mr)[i])
+			return "MR section";
+
+	/* the CSRs go to the DMEM after the message block */
+	qb_test_clear(DMEM_OFFSET_ADDR + DDRPHY_QB_MSB_SIZE, DDRPHY_QB_CSR_SIZE);
+	qb_test_clear(ACSM_SRAM_BASE_ADDR, DDRPHY_QB_ACSM_SIZE);
+	qb_test_clear(PSTATE_SRAM_BASE_ADDR, DDRPHY_QB_PST_SIZE);
+#if defined(CONFIG_DDR_QB_COMPRESS)
+	ddrphy_qb_rle_unpack(ddrphy_qb_sect(hdr, DDRPHY_QB_SECT_CSR),
+			     DMEM_OFFSET_ADDR + DDRPHY_QB_MSB_SIZE, DDRPHY_QB_CSR_SIZE);
+	ddrphy_qb_rle_unpack(ddrphy_qb_sect(hdr, DDRPHY_QB_SECT_ACSM), ACSM_SRAM_BASE_ADDR,
+			     DDRPHY_QB_ACSM_SIZE);
+	ddrphy_qb_rle_unpack(ddrphy_qb_sect(hdr, DDRPHY_QB_SECT_PST), PSTATE_SRAM_BASE_ADDR,
+			     DDRPHY_QB_PST_SIZE);
+#else
+	ddrphy_sram_xfer_start(&sram, ddrphy_qb_sect(hdr, DDRPHY_QB_SECT_CSR),
+			       DMEM_OFFSET_ADDR + DDRPHY_QB_MSB_SIZE, DDRPHY_QB_CSR_SIZE, true);
+	ddrphy_sram_xfer_wait(&sram);
+	ddrphy_sram_xfer_start(&sram, ddrphy_qb_sect(hdr, DDRPHY_QB_SECT_ACSM), ACSM_SRAM_BASE_ADDR,
+			       DDRPHY_QB_ACSM_SIZE, true);
+	ddrphy_sram_xfer_wait(&sram);
+	ddrphy_sram_xfer_start(&sram, ddrphy_qb_sect(hdr, DDRPHY_QB_SECT_PST), PSTATE_SRAM_BASE_ADDR,
+			       DDRPHY_QB_PST_SIZE, true);
+	ddrphy_sram_xfer_wait(&sram);
+#endif
+
+	err = qb_test_cmp(qb_ref_csr, DMEM_OFFSET_ADDR + DDRPHY_QB_MSB_SIZE, DDRPHY_QB_CSR_SIZE,
+			  "CSR section");
+	if (!err)
+		err = qb_test_cmp(qb_ref_acsm, ACSM_SRAM_BASE_ADDR, DDRPHY_QB_ACSM_SIZE,
+				  "ACSM section");
+	if (!err)
+		err = qb_test_cmp(qb_ref_pst, PSTATE_SRAM_BASE_ADDR, DDRPHY_QB_PST_SIZE,
+				  "PState section");
+
+	return err;
+}
+
+/* A corrupted SRAM section or header field has to be caught */
+const char *qb_test_corrupt(void)
+{
+	ddrphy_qb_hdr *hdr = (ddrphy_qb_hdr *)QB_STATE_MEM;
+	u8 *acsm = ddrphy_qb_sect(hdr, DDRPHY_QB_SECT_ACSM);
+
+	acsm[hdr->sect[DDRPHY_QB_SECT_ACSM].size / 2] ^= 1;
+	if (ddrphy_qb_sects_ok(hdr, DDRPHY_QB_SECT_ACSM, DDRPHY_QB_SECT_ACSM) ||
+	    !ddrphy_qb_sects_ok(hdr, DDRPHY_QB_SECT_MR, DDRPHY_QB_SECT_CSR))
+		return "ACSM corruption";
+	acsm[hdr->sect[DDRPHY_QB_SECT_ACSM].size / 2] ^= 1;
+
+	hdr->sect[DDRPHY_QB_SECT_PST].size += sizeof(u16);
+	if (!ddrphy_qb_check_hdr(hdr, &dram_timing))
+		return "header corruption";
+	hdr->sect[DDRPHY_QB_SECT_PST].size -= sizeof(u16);
+
+	hdr->drate[0]++;
+	hdr->crc = crc32(hdr, sizeof(*hdr) - sizeof(u32));
+	if (!ddrphy_qb_check_hdr(hdr, &dram_timing))
+		return "data rate change";
+	hdr->drate[0]--;
+	hdr->crc = crc32(hdr, sizeof(*hdr) - sizeof(u32));
+
+	return NULL;
+}
+
+void qb_test_image_clear(void)
+{
+	u32 i;
+
+	for (i = 0; i < ARRAY_SIZE(qb_test_image); i++)
+		qb_test_image[i] = 0;
+}
+
+/* Write the saved state to its image slot, without the commit word for a torn write */
+void qb_test_persist(bool commit)
+{
+	ddrphy_qb_hdr *hdr = (ddrphy_qb_hdr *)QB_STATE_MEM;
+	u8 *slot = (u8 *)qb_test_image + hdr->slot * DDRPHY_QB_SLOT_SIZE;
+	u32 i, size = hdr->size + (commit ? sizeof(u32) : 0);
+
+	for (i = 0; i < size; i++)
+		slot[i] = ((u8 *)hdr)[i];
+}
+
+/* Committed slots ddrphy_qb_slots() returns, and the newest one */
+unsigned int qb_test_slots(unsigned int *slot, unsigned int *gen)
+{
+	ddrphy_qb_hdr *slots[DDRPHY_QB_SLOTS];
+	u32 num;
+
+	num = ddrphy_qb_slots(slots, &dram_timing);
+	if (num) {
+		*slot = slots[0]->slot;
+		*gen = slots[0]->gen;
+	}
+
+	return num;
+}
+
+/* Give the state of an image slot another generation, committed */
+void qb_test_set_gen(unsigned int slot, unsigned int gen)
+{
+	ddrphy_qb_hdr *hdr = (ddrphy_qb_hdr *)((u8 *)qb_test_image + slot * DDRPHY_QB_SLOT_SIZE);
+
+	hdr->gen = gen;
+	hdr->crc = crc32(hdr, sizeof(*hdr) - sizeof(u32));
+	*(u32 *)((u8 *)hdr + hdr->size) = ~hdr->crc;
+}
+
+/* Move the data rate of the first FSP, the slots no longer match */
+void qb_test_drate(int delta)
+{
+	dram_timing.fsp_msg[0].drate += delta;
+}
+#endif
@@ -0,0 +1,191 @@
+// SPDX-License-Identifier: GPL-2.0+
+/*
+ * Copyright 2024 NXP
+ *
+ * Host test of the QuickBoot state, raw or run-length encoded (QB_COMPRESS):
+ * a simulated PHY is filled with random, constant and trained-like values,
+ * the state is saved from it, checked, restored to the cleared PHY and
+ * compared; corrupted sections and headers have to be rejected. The size of
+ * each state is printed against the raw layout. The image slots then take
+ * successive states, a torn write, a generation wrap and a data rate change.
+ *
+ * qb_test --save <file> dumps a trained-like state, unstamped by a
+ * training-only build, qb_test --slots <file> prints the newest committed
+ * slot of an image dump and qb_test --slot-size DDRPHY_QB_SLOT_SIZE, for
+ * stamp_test.py.
+ */
+#include <stdio.h>
+#include <string.h>
+
+#define PHY_REGS	(1 << 21)
+#define MODES		3
+#define SEEDS		4
+
+unsigned int qb_test_save(unsigned int mode, unsigned int seed);
+const void *qb_test_state_data(unsigned int *size);
+void *qb_test_image_data(unsigned int *size);
+unsigned int qb_test_slot_size(void);
+unsigned int qb_test_raw_size(void);
+const char *qb_test_restore(void);
+const char *qb_test_corrupt(void);
+void qb_test_image_clear(void);
+void qb_test_persist(_Bool commit);
+unsigned int qb_test_slots(unsigned int *slot, unsigned int *gen);
+void qb_test_set_gen(unsigned int slot, unsigned int gen);
+void qb_test_drate(int delta);
+
+/* PHY APB space, one word per APB address, the CSRs reach 0x19xxxx */
+unsigned int qb_sim_phy[PHY_REGS];
+
+/* time.h of the firmware, not timed */
+void udelay(unsigned int us)
+{
+	(void)us;
+}
+
+unsigned int timer_get_us(void)
+{
+	return 0;
+}
+
+static int save_file(const char *file)
+{
+	const void *data;
+	unsigned int size;
+	FILE *f;
+
+	qb_test_save(MODES - 1, 1);
+	data = qb_test_state_data(&size);
+	f = fopen(file, "wb");
+	if (!f || fwrite(data, 1, size, f) != size) {
+		printf("%s: cannot write\n", file);
+		return 1;
+	}
+	fclose(f);
+
+	return 0;
+}
+
+#if defined(CONFIG_DDR_QBOOT_AUTO)
+static const char *const modes[MODES] = { "random", "constant", "trained" };
+
+/* Save, check, restore and corrupt states of each kind */
+static unsigned int check_states(const char *name)
+{
+	const char *err;
+	unsigned int mode, seed, size, max, fail = 0;
+
+	for (mode = 0; mode < MODES; mode++) {
+		for (seed = 1, max = 0; seed <= SEEDS; seed++) {
+			size = qb_test_save(mode, seed);
+			if (size > max)
+				max = size;
+			err = qb_test_restore();
+			if (!err)
+				err = qb_test_corrupt();
+			if (!err)
+				err = qb_test_restore();
+			if (err) {
+				printf("%s: %s state %u: %s mismatch\n", name, modes[mode], seed, err);
+				fail++;
+			}
+		}
+		printf("%s: %s states: %u bytes at most, raw layout %u bytes\n", name, modes[mode],
+		       max, qb_test_raw_size());
+	}
+
+	return fail;
+}
+
+static int slots_file(const char *file)
+{
+	unsigned int size, num, slot = 0, gen = 0;
+	void *image = qb_test_image_data(&size);
+	FILE *f;
+
+	qb_test_image_clear();
+	f = fopen(file, "rb");
+	if (!f) {
+		printf("%s: cannot read\n", file);
+		return 1;
+	}
+	if (fread(image, 1, size, f) == 0)
+		printf("%s: empty image\n", file);
+	fclose(f);
+
+	num = qb_test_slots(&slot, &gen);
+	printf("%u slot(s), newest slot %u generation %u\n", num, slot, gen);
+
+	return 0;
+}
+
+#define CHECK_SLOTS(what, n, s, g) \
+	do { \
+		num = qb_test_slots(&slot, &gen); \
+		if (num != (n) || (num && (slot != (s) || gen != (g)))) { \
+			printf("%s: %s: %u slot(s), newest slot %u generation %u\n", \
+			       name, what, num, slot, gen); \
+			fail++; \
+		} \
+	} while (0)
+
+/**
+ * The training flow saves the next generation for the other slot, a torn
+ * write leaves the previous state newest, generations compare modulo 2^32
+ */
+static unsigned int check_slots(const char *name)
+{
+	unsigned int k, num, slot = 0, gen = 0, fail = 0;
+
+	qb_test_image_clear();
+	for (k = 1; k <= 4; k++) {
+		qb_test_save(MODES - 1, k);
+		qb_test_persist(1);
+		CHECK_SLOTS("save", k < 2 ? k : 2, (k - 1) % 2, k);
+	}
+
+	qb_test_save(MODES - 1, k);
+	qb_test_persist(0);
+	CHECK_SLOTS("torn write", 1, 1, 4);
+
+	qb_test_save(MODES - 1, k);
+	qb_test_persist(1);
+	qb_test_set_gen(0, 0xffffffff);
+	qb_test_set_gen(1, 1);
+	CHECK_SLOTS("generation wrap", 2, 1, 1);
+
+	qb_test_drate(1);
+	CHECK_SLOTS("data rate change", 0, 0, 0);
+	qb_test_drate(-1);
+
+	return fail;
+}
+#endif
+
+int main(int argc, char **argv)
+{
+	const char *name = argc > 1 ? argv[1] : "";
+#if defined(CONFIG_DDR_QBOOT_AUTO)
+	unsigned int fail;
+#endif
+
+	if (argc > 2 && !strcmp(argv[1], "--save"))
+		return save_file(argv[2]);
+	if (argc > 1 && !strcmp(argv[1], "--slot-size")) {
+		printf("%u\n", qb_test_slot_size());
+		return 0;
+	}
+#if defined(CONFIG_DDR_QBOOT_AUTO)
+	if (argc > 2 && !strcmp(argv[1], "--slots"))
+		return slots_file(argv[2]);
+
+	fail = check_states(name);
+	fail += check_slots(name);
+
+	printf("%s: %s, %u failure(s)\n", name, fail ? "FAILED" : "passed", fail);
+	return fail ? 1 : 0;
+#else
+	printf("%s: training-only build, --save <file> or --slot-size only\n", name);
+	return 1;
+#endif
+}
@@ -0,0 +1,58 @@
+#!/usr/bin/env python3
+# SPDX-License-Identifier: GPL-2.0+
+#
+# Copyright 2024 NXP
+#
+# Host test of scripts/ddr_qb_stamp.py: a state saved unstamped by a
+# training-only build is stamped three times into an empty image, the
+# slots have to alternate with generations 1, 2, 3 and be the newest for
+# ddrphy_qb_slots() of a QBOOT=auto build. Once the header of the newest
+# slot is corrupted, the next stamp has to refill that slot with the
+# generation after the remaining one.
+#
+#   stamp_test.py <name> <training-only qb_test> <QBOOT=auto qb_test> <dir>
+
+import os
+import subprocess
+import sys
+
+STAMP = os.path.join(os.path.dirname(__file__), '..', '..', 'scripts', 'ddr_qb_stamp.py')
+
+
+def run(*args):
+    return subprocess.run(args, check=True, capture_output=True, text=True).stdout
+
+
+def main():
+    name, train, auto, out = sys.argv[1:5]
+    state = os.path.join(out, 'state.bin')
+    image = os.path.join(out, 'image.bin')
+    slot_size = int(run(auto, '--slot-size'))
+    fail = 0
+
+    run(train, '--save', state)
+    open(image, 'wb').close()
+
+    def stamp(what, slot, gen):
+        nonlocal fail
+        run(sys.executable, STAMP, '--offset', '0', '--slot-size', str(slot_size), state, image)
+        slots = run(auto, '--slots', image).strip()
+        expected = '%d slot(s), newest slot %d generation %d' % (min(gen, 2), slot, gen)
+        if slots != expected:
+            print('%s: %s: %s, expected %s' % (name, what, slots, expected))
+            fail += 1
+
+    for gen in (1, 2, 3):
+        stamp('stamp %d' % gen, (gen - 1) % 2, gen)
+
+    # slot 0 holds generation 3, its magic no longer matches
+    with open(image, 'r+b') as f:
+        f.write(b'\0')
+    stamp('stamp over a corrupted slot', 0, 3)
+
+    print('%s: stamp %s, %d failure(s)' % (name, 'FAILED' if fail else 'passed', fail))
+    return 1 if fail else 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,18 @@
+/* SPDX-License-Identifier: GPL-2.0+ */
+/*
+ * Copyright 2024 NXP
+ *
+ * Host build of the memory map: the DDR PHY APB window is the simulated
+ * PHY register file of seq_test.c, which BURST/FILL runs write directly.
+ */
+#ifndef SEQ_TEST_SOC_MEMORY_MAP_H
+#define SEQ_TEST_SOC_MEMORY_MAP_H
+
+#include_next <asm/arch/soc_memory_map.h>
+
+extern unsigned int seq_sim_phy[];
+
+#undef DDRPHY_BASE
+#define DDRPHY_BASE		((unsigned long)seq_sim_phy)
+
+#endif
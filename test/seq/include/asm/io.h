@@ -0,0 +1,22 @@
+/* SPDX-License-Identifier: GPL-2.0+ */
+/*
+ * Copyright 2024 NXP
+ *
+ * Host build of the register accessors: readl()/writel() go to the
+ * simulated register file of seq_test.c.
+ */
+#ifndef SEQ_TEST_IO_H
+#define SEQ_TEST_IO_H
+
+#include_next <asm/io.h>
+
+#undef readl
+#undef writel
+
+unsigned int seq_sim_readl(unsigned long addr);
+void seq_sim_writel(unsigned int val, unsigned long addr);
+
+#define readl(addr)		seq_sim_readl((unsigned long)(addr))
+#define writel(val, addr)	seq_sim_writel((val), (unsigned long)(addr))
+
+#endif
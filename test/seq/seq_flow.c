@@ -0,0 +1,87 @@
+// SPDX-License-Identifier: GPL-2.0+
+/*
+ * Copyright 2024 NXP
+ *
+ * PHY tables of a board timing file applied in the training flow order,
+ * built with the repo headers: through ddr_seq_run() for the run-encoded
+ * tables of a PHY_BURST build, one APB write per entry otherwise.
+ */
+#include "ddr.h"
+
+void seq_sim_mark(unsigned int point);
+
+static int seq_flow_cfg(ddrphy_cfg_tbl *cfg, unsigned int num)
+{
+#if defined(CONFIG_DDRPHY_BURST)
+	return ddr_seq_run(cfg, num);
+#else
+	unsigned int i;
+
+	for (i = 0; i < num; i++, cfg++)
+		dwc_ddrphy_apb_wr(cfg->reg, cfg->val);
+
+	return 0;
+#endif
+}
+
+/**
+ * The PHY state is marked where the training firmware would run and at the
+ * end, the points PHY_COALESCE keeps the state of.
+ */
+int seq_flow_apply(void)
+{
+	struct dram_timing_info *dtiming = &dram_timing;
+	struct dram_fsp_msg *fsp_msg = dtiming->fsp_msg;
+	unsigned int i, point = 0;
+	int ret;
+
+	ret = seq_flow_cfg(dtiming->ddrphy_cfg, dtiming->ddrphy_cfg_num);
+	for (i = 0; !ret && i < dtiming->fsp_msg_num; i++, fsp_msg++) {
+		ret = seq_flow_cfg(fsp_msg->fsp_phy_cfg, fsp_msg->fsp_phy_cfg_num);
+		if (ret)
+			break;
+		seq_sim_mark(point++);
+		ret = seq_flow_cfg(fsp_msg->fsp_phy_pie_cfg, fsp_msg->fsp_phy_pie_cfg_num);
+	}
+	if (!ret)
+		ret = seq_flow_cfg(dtiming->ddrphy_pie, dtiming->ddrphy_pie_num);
+	if (!ret)
+		seq_sim_mark(point);
+
+	return ret;
+}
+
+/* Opcode checks of seq_test.c, the sequences use the ddr.h macros */
+#define SEQ_TEST_REG	0x5e080120U
+
+static const unsigned short seq_test_ops[] = {
+	SEQ_WR(SEQ_TEST_REG, 0x12345678),
+	SEQ_CLRSETBITS(SEQ_TEST_REG, 0x0000ff00, 0x00000a00),
+	SEQ_SETBITS(SEQ_TEST_REG + 4, BIT(3)),
+	SEQ_PHY_WR(0x20010, 0xbeef),
+	DDRPHY_BURST(0x10040, 3), 1, 2, 3,
+	DDRPHY_FILL(0x90000, 4), 0x55,
+	SEQ_POLL(SEQ_TEST_REG, 0xff00, 0x0a00, 10),
+	SEQ_UDELAY(7),
+};
+
+static const unsigned short seq_test_tmo[] = {
+	SEQ_POLL(SEQ_TEST_REG, 0x80000000U, 0x80000000U, 50),
+	SEQ_WR(SEQ_TEST_REG, 0),
+};
+
+static const unsigned short seq_test_bad[] = {
+	DDR_SEQ_HDR(0xf, 0),
+};
+
+int seq_test_run(unsigned int test)
+{
+	switch (test) {
+	case 0:
+		return ddr_seq_exec(seq_test_ops);
+	case 1:
+		return ddr_seq_exec(seq_test_tmo);
+	default:
+		return ddr_seq_exec(seq_test_bad);
+	}
+}
@@ -0,0 +1,164 @@
+// SPDX-License-Identifier: GPL-2.0+
+/*
+ * Copyright 2024 NXP
+ *
+ * Host test of source/ddr/ddr_seq.c against a simulated register file:
+ * each opcode is checked, then the PHY tables of a board timing file are
+ * applied in the training flow order and timed. The PHY state hash at
+ * each firmware run point is printed, the Makefile compares the one of
+ * the raw tables with the ones of the PHY_BURST and PHY_COALESCE tables.
+ */
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#define PHY_REGS	(1 << 20)
+#define SIM_REGS	8
+#define POINTS_MAX	8
+#define BENCH_LOOPS	200
+
+int seq_flow_apply(void);
+int seq_test_run(unsigned int test);
+
+/* PHY APB space, one word per 20-bit APB address */
+unsigned int seq_sim_phy[PHY_REGS];
+
+/* other registers, by address */
+static struct {
+	unsigned long addr;
+	unsigned int val;
+} sim_regs[SIM_REGS];
+
+static unsigned int sim_points, sim_hash[POINTS_MAX], sim_delay, sim_bench;
+
+static unsigned int *sim_reg(unsigned long addr)
+{
+	unsigned long phy = (unsigned long)seq_sim_phy;
+	unsigned int i;
+
+	if (addr >= phy && addr < phy + sizeof(seq_sim_phy))
+		return &seq_sim_phy[(addr - phy) / 4];
+
+	for (i = 0; i < SIM_REGS && sim_regs[i].addr; i++) {
+		if (sim_regs[i].addr == addr)
+			break;
+	}
+	if (i == SIM_REGS) {
+		printf("register file full at 0x%08lx\n", addr);
+		i = 0;
+	}
+	sim_regs[i].addr = addr;
+
+	return &sim_regs[i].val;
+}
+
+unsigned int seq_sim_readl(unsigned long addr)
+{
+	return *sim_reg(addr);
+}
+
+void seq_sim_writel(unsigned int val, unsigned long addr)
+{
+	*sim_reg(addr) = val;
+}
+
+/* FNV-1a hash of the PHY state at a firmware run point */
+void seq_sim_mark(unsigned int point)
+{
+	unsigned int i, hash = 0x811c9dc5;
+
+	if (sim_bench || point >= POINTS_MAX)
+		return;
+
+	for (i = 0; i < PHY_REGS; i++)
+		hash = (hash ^ seq_sim_phy[i]) * 0x01000193;
+	sim_hash[point] = hash;
+	sim_points = point + 1;
+}
+
+static double now(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/* time.h of the firmware, on the host clock from the test start as at boot */
+unsigned int timer_get_us(void)
+{
+	static double start;
+
+	if (!start)
+		start = now();
+	return (now() - start) * 1e6;
+}
+
+/* same test as source/utils/time-cm33.c */
+int time_after(unsigned int us, unsigned int timeout)
+{
+	return timer_get_us() + timeout > us;
+}
+
+void udelay(unsigned int us)
+{
+	sim_delay += us;
+}
+
+static unsigned int check_ops(void)
+{
+	unsigned int fail = 0;
+	int ret;
+
+#define CHECK(cond) \
+	do { if (!(cond)) { printf("failed: %s\n", #cond); fail++; } } while (0)
+
+	ret = seq_test_run(0);
+	CHECK(ret == 0);
+	CHECK(seq_sim_readl(0x5e080120U) == 0x12340a78);
+	CHECK(seq_sim_readl(0x5e080124U) == 0x8);
+	CHECK(seq_sim_phy[0x20010] == 0xbeef);
+	CHECK(seq_sim_phy[0x10040] == 1 && seq_sim_phy[0x10041] == 2 &&
+	      seq_sim_phy[0x10042] == 3 && seq_sim_phy[0x10043] == 0);
+	CHECK(seq_sim_phy[0x90000] == 0x55 && seq_sim_phy[0x90003] == 0x55 &&
+	      seq_sim_phy[0x90004] == 0);
+	CHECK(sim_delay == 7);
+
+	/* a POLL timeout stops the sequence */
+	ret = seq_test_run(1);
+	CHECK(ret == -110);
+	CHECK(seq_sim_readl(0x5e080120U) == 0x12340a78);
+
+	ret = seq_test_run(2);
+	CHECK(ret == -22);
+
+	return fail;
+}
+
+int main(int argc, char *argv[])
+{
+	unsigned int i, fail;
+	double t;
+
+	fail = check_ops();
+
+	memset(seq_sim_phy, 0, sizeof(seq_sim_phy));
+	if (seq_flow_apply()) {
+		printf("%s: PHY tables rejected\n", argc > 1 ? argv[1] : "");
+		fail++;
+	}
+	for (i = 0; i < sim_points && i < POINTS_MAX; i++)
+		printf("%s: PHY state %u: 0x%08x\n", argc > 1 ? argv[1] : "", i, sim_hash[i]);
+
+	sim_bench = 1;
+	t = now();
+	for (i = 0; i < BENCH_LOOPS; i++)
+		seq_flow_apply();
+	t = now() - t;
+	printf("%s: PHY tables applied in %.1f us\n", argc > 1 ? argv[1] : "",
+	       t * 1e6 / BENCH_LOOPS);
+
+	if (fail)
+		printf("FAILED, %u failure(s)\n", fail);
+	return fail ? 1 : 0;
+}